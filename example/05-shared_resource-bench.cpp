@@ -0,0 +1,93 @@
+#include "nonstd/scope/shared_resource.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+using namespace nonstd;
+
+// Compare shared_resource with std::shared_ptr<unique_resource>:
+// creation, and copying/destroying a share.
+
+namespace {
+
+long closed = 0;
+
+void close_handle( int ) { ++closed; }
+
+typedef unique_resource<int, void(*)(int)> unique_handle;
+
+template< class Fn >
+double ns_per_op( long n, Fn fn )
+{
+    auto const start = std::chrono::steady_clock::now();
+    fn( n );
+    auto const stop  = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::nano>( stop - start ).count() / double( n );
+}
+
+template< class Policy >
+void create_shared_resource( long n )
+{
+    for ( long i = 0; i < n; ++i )
+    {
+        shared_resource<int, void(*)(int), Policy> r( unique_handle( int( i ), close_handle ) );
+    }
+}
+
+void create_shared_ptr( long n )
+{
+    for ( long i = 0; i < n; ++i )
+    {
+        auto r = std::make_shared<unique_handle>( int( i ), close_handle );
+    }
+}
+
+template< class Policy >
+void copy_shared_resource( long n )
+{
+    shared_resource<int, void(*)(int), Policy> r( unique_handle( 1, close_handle ) );
+
+    for ( long i = 0; i < n; ++i )
+    {
+        shared_resource<int, void(*)(int), Policy> c( r );
+    }
+}
+
+void copy_shared_ptr( long n )
+{
+    auto r = std::make_shared<unique_handle>( 1, close_handle );
+
+    for ( long i = 0; i < n; ++i )
+    {
+        std::shared_ptr<unique_handle> c( r );
+    }
+}
+
+} // anonymous namespace
+
+int main()
+{
+    long const n = 10 * 1000 * 1000;
+
+    // Let the standard library know the process is multi-threaded,
+    // so shared_ptr does not switch to non-atomic counting:
+
+    std::thread( []{} ).join();
+
+    std::cout << "create, ns/op:\n"
+        << "  shared_resource<nonatomic_count>: " << ns_per_op( n, create_shared_resource<nonatomic_count> ) << "\n"
+        << "  shared_resource<atomic_count>   : " << ns_per_op( n, create_shared_resource<atomic_count> ) << "\n"
+        << "  shared_ptr<unique_resource>     : " << ns_per_op( n, create_shared_ptr ) << "\n";
+
+    std::cout << "copy and destroy, ns/op:\n"
+        << "  shared_resource<nonatomic_count>: " << ns_per_op( n, copy_shared_resource<nonatomic_count> ) << "\n"
+        << "  shared_resource<atomic_count>   : " << ns_per_op( n, copy_shared_resource<atomic_count> ) << "\n"
+        << "  shared_ptr<unique_resource>     : " << ns_per_op( n, copy_shared_ptr ) << "\n";
+
+    return closed == 3 * n + 3 ? 0 : 1;
+}
+
+// g++ -std=c++11 -O2 -Wall -I../include -o 05-shared_resource-bench 05-shared_resource-bench.cpp -pthread && ./05-shared_resource-bench
@@ -0,0 +1,126 @@
+#include "nonstd/scope/atomic_unique_resource.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#if scope_CPP17_OR_GREATER
+# include <mutex>
+# include <shared_mutex>
+#endif
+
+using namespace nonstd;
+
+// Reader scaling of atomic_unique_resource versus a unique_resource protected
+// by a std::shared_mutex, with one writer replacing the resource every 100us.
+
+namespace {
+
+void close_handle( int ) {}
+
+typedef unique_resource<int, void(*)(int)> handle;
+
+struct hazard_protected
+{
+    atomic_unique_resource<int, void(*)(int)> resource{ handle( 0, close_handle ) };
+
+    int read()
+    {
+        return resource.load().get();
+    }
+
+    void write( int i )
+    {
+        resource.store( handle( i, close_handle ) );
+    }
+};
+
+#if scope_CPP17_OR_GREATER
+
+struct mutex_protected
+{
+    std::shared_mutex mutex;
+    handle resource{ 0, close_handle };
+
+    int read()
+    {
+        std::shared_lock<std::shared_mutex> lock( mutex );
+        return resource.get();
+    }
+
+    void write( int i )
+    {
+        std::unique_lock<std::shared_mutex> lock( mutex );
+        resource = handle( i, close_handle );
+    }
+};
+
+#endif
+
+// Million reads per second for all readers together:
+
+template< class Protected >
+double run( int readers )
+{
+    Protected p;
+
+    std::atomic<bool> done( false );
+    std::atomic<long> reads( 0 );
+
+    std::vector<std::thread> threads;
+
+    for ( int t = 0; t < readers; ++t )
+    {
+        threads.emplace_back( [&]{
+            long n = 0;
+            long sum = 0;
+            while ( !done.load( std::memory_order_relaxed ) )
+            {
+                sum += p.read();
+                ++n;
+            }
+            reads += n + ( sum < 0 );
+        });
+    }
+
+    std::thread writer( [&]{
+        for ( int i = 1; !done.load( std::memory_order_relaxed ); ++i )
+        {
+            p.write( i );
+            std::this_thread::sleep_for( std::chrono::microseconds( 100 ) );
+        }
+    });
+
+    auto const duration = std::chrono::milliseconds( 500 );
+
+    std::this_thread::sleep_for( duration );
+    done = true;
+
+    for ( auto & t : threads )
+        t.join();
+    writer.join();
+
+    return double( reads.load() ) / std::chrono::duration<double, std::micro>( duration ).count();
+}
+
+} // anonymous namespace
+
+int main()
+{
+    std::cout << "readers  atomic_unique_resource  shared_mutex  [Mreads/s]\n";
+
+    for ( int readers = 1; readers <= 8; readers *= 2 )
+    {
+        std::cout << readers << "\t " << run<hazard_protected>( readers )
+#if scope_CPP17_OR_GREATER
+            << "\t\t\t " << run<mutex_protected>( readers )
+#else
+            << "\t\t\t (std::shared_mutex requires C++17)"
+#endif
+            << "\n";
+    }
+}
+
+// g++ -std=c++17 -O2 -Wall -I../include -o 06-atomic_unique_resource-bench 06-atomic_unique_resource-bench.cpp -pthread && ./06-atomic_unique_resource-bench
@@ -0,0 +1,122 @@
+#include "nonstd/scope/ebr_domain.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace nonstd;
+
+// Throughput of an epoch-protected pointer versus a mutex-protected
+// unique_resource, under read-heavy (95% reads) and write-heavy (50% reads) mixes.
+
+namespace {
+
+struct payload { long value; };
+
+void free_payload( payload * p ) { delete p; }
+
+typedef unique_resource<payload *, void(*)(payload *)> owned_payload;
+
+struct epoch_protected
+{
+    ebr_domain domain;
+    std::atomic<payload *> current{ new payload{ 0 } };
+
+    ~epoch_protected()
+    {
+        delete current.load();
+    }
+
+    long read()
+    {
+        scope_epoch guard( domain );
+        return current.load( std::memory_order_acquire )->value;
+    }
+
+    void write( long v )
+    {
+        payload * old = current.exchange( new payload{ v }, std::memory_order_acq_rel );
+        domain.retire( owned_payload( old, free_payload ) );
+    }
+};
+
+struct mutex_protected
+{
+    std::mutex mutex;
+    owned_payload current{ new payload{ 0 }, free_payload };
+
+    long read()
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        return current->value;
+    }
+
+    void write( long v )
+    {
+        owned_payload next( new payload{ v }, free_payload );
+        std::lock_guard<std::mutex> lock( mutex );
+        current = std::move( next );
+    }
+};
+
+// Million operations per second for all threads together:
+
+template< class Protected >
+double run( int threads, int read_percentage )
+{
+    Protected p;
+
+    std::atomic<bool> done( false );
+    std::atomic<long> ops( 0 );
+
+    std::vector<std::thread> workers;
+
+    for ( int t = 0; t < threads; ++t )
+    {
+        workers.emplace_back( [&]{
+            long n = 0;
+            long sum = 0;
+            while ( !done.load( std::memory_order_relaxed ) )
+            {
+                if ( n % 100 < read_percentage )
+                    sum += p.read();
+                else
+                    p.write( n );
+                ++n;
+            }
+            ops += n + ( sum < 0 );
+        });
+    }
+
+    auto const duration = std::chrono::milliseconds( 300 );
+
+    std::this_thread::sleep_for( duration );
+    done = true;
+
+    for ( auto & t : workers )
+        t.join();
+
+    return double( ops.load() ) / std::chrono::duration<double, std::micro>( duration ).count();
+}
+
+} // anonymous namespace
+
+int main()
+{
+    for ( int reads : { 95, 50 } )
+    {
+        std::cout << "\n" << reads << "% reads\nthreads  ebr_domain  mutex  [Mops/s]\n";
+
+        for ( int threads = 1; threads <= 8; threads *= 2 )
+        {
+            std::cout << threads
+                << "\t " << run<epoch_protected>( threads, reads )
+                << "\t     " << run<mutex_protected>( threads, reads ) << "\n";
+        }
+    }
+}
+
+// g++ -std=c++11 -O2 -Wall -I../include -o 07-ebr_domain-bench 07-ebr_domain-bench.cpp -pthread && ./07-ebr_domain-bench
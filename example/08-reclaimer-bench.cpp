@@ -0,0 +1,75 @@
+#include "nonstd/scope/reclaimer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace nonstd;
+
+// Request latency (p50, p99) when every 16th resource has a slow deleter,
+// with the deleter run synchronously versus offloaded to a reclaimer.
+
+namespace {
+
+typedef std::chrono::steady_clock clock_type;
+
+struct slow_close
+{
+    void operator()( int handle ) const
+    {
+        if ( handle % 16 == 0 )
+            std::this_thread::sleep_for( std::chrono::microseconds( 500 ) );   // e.g. close() with dirty pages
+    }
+};
+
+template< class Deleter >
+double request( int i, Deleter const & d )
+{
+    auto const start = clock_type::now();
+    {
+        auto r = make_unique_resource_checked( i, -1, d );
+
+        volatile long work = 0;
+        for ( int k = 0; k < 2000; ++k )
+            work = work + k;
+    }
+    return std::chrono::duration<double, std::micro>( clock_type::now() - start ).count();
+}
+
+void report( char const * title, std::vector<double> latency )
+{
+    std::sort( latency.begin(), latency.end() );
+
+    std::cout << title
+        << "  p50: " << latency[ latency.size() / 2 ] << " us"
+        << ", p99: " << latency[ latency.size() * 99 / 100 ] << " us\n";
+}
+
+} // anonymous namespace
+
+int main()
+{
+    int const n = 5000;
+
+    std::vector<double> sync_latency;
+    std::vector<double> offload_latency;
+
+    for ( int i = 0; i < n; ++i )
+        sync_latency.push_back( request( i, slow_close() ) );
+
+    // scope:
+    {
+        reclaimer r;
+        auto const d = make_offload_deleter( slow_close(), r );
+
+        for ( int i = 0; i < n; ++i )
+            offload_latency.push_back( request( i, d ) );
+    }
+
+    report( "synchronous deleter:", sync_latency );
+    report( "offload_deleter    :", offload_latency );
+}
+
+// g++ -std=c++11 -O2 -Wall -I../include -o 08-reclaimer-bench 08-reclaimer-bench.cpp -pthread && ./08-reclaimer-bench
@@ -0,0 +1,55 @@
+#include "nonstd/scope/uring_close.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <iostream>
+
+using namespace nonstd;
+
+// Descriptor churn: open and close 1M descriptors, closing each via
+// close() versus via batched IORING_OP_CLOSE submissions.
+
+namespace {
+
+typedef std::chrono::steady_clock clock_type;
+
+struct close_fd
+{
+    void operator()( int fd ) const noexcept
+    {
+        ::close( fd );
+    }
+};
+
+template< class Deleter >
+double churn( int n, Deleter const & d )
+{
+    auto const start = clock_type::now();
+
+    for ( int i = 0; i < n; ++i )
+    {
+        auto fd = make_unique_resource_checked( ::open( "/dev/null", O_RDONLY ), -1, d );
+    }
+
+    uring_close_deleter::flush();
+
+    return std::chrono::duration<double>( clock_type::now() - start ).count();
+}
+
+} // anonymous namespace
+
+int main()
+{
+    int const n = 1000000;
+
+    double const sync_time  = churn( n, close_fd() );
+    double const uring_time = churn( n, uring_close_deleter() );
+
+    std::cout << "io_uring available  : " << ( uring_close_deleter::is_available() ? "yes" : "no (close() fallback)" ) << "\n"
+        << "close()             : " << sync_time  << " s, " << 1e9 * sync_time  / n << " ns/fd\n"
+        << "uring_close_deleter : " << uring_time << " s, " << 1e9 * uring_time / n << " ns/fd\n";
+}
+
+// g++ -std=c++11 -O2 -Wall -I../include -o 09-uring_close-bench 09-uring_close-bench.cpp -pthread && ./09-uring_close-bench
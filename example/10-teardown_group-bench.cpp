@@ -0,0 +1,62 @@
+#include "nonstd/scope/teardown_group.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+using namespace nonstd;
+
+// Shard teardown: 8 independent shards with 200 resources each, where every
+// 10th release blocks briefly (e.g. close() of a file with dirty pages),
+// torn down serially versus on 4 threads.
+
+namespace {
+
+typedef std::chrono::steady_clock clock_type;
+
+void release( int handle )
+{
+    if ( handle % 10 == 0 )
+        std::this_thread::sleep_for( std::chrono::microseconds( 200 ) );
+}
+
+void populate( teardown_plan & plan )
+{
+    for ( int s = 0; s < 8; ++s )
+    {
+        teardown_group & shard = plan.group( "shard" + std::to_string( s ) );
+
+        for ( int i = 0; i < 200; ++i )
+            shard.adopt( make_unique_resource_checked( i, -1, release ) );
+    }
+}
+
+double measure( std::size_t threads )
+{
+    teardown_plan plan;
+    populate( plan );
+
+    auto const start = clock_type::now();
+    auto const reports = plan.teardown( threads );
+    double const total = std::chrono::duration<double, std::milli>( clock_type::now() - start ).count();
+
+    std::cout << threads << " thread(s): " << total << " ms";
+    for ( auto const & r : reports )
+        std::cout << "  " << r.name << ": " << std::chrono::duration<double, std::milli>( r.duration ).count() << " ms";
+    std::cout << "\n";
+
+    return total;
+}
+
+} // anonymous namespace
+
+int main()
+{
+    double const serial   = measure( 1 );
+    double const parallel = measure( 4 );
+
+    std::cout << "speedup: " << serial / parallel << "\n";
+}
+
+// g++ -std=c++11 -O2 -Wall -I../include -o 10-teardown_group-bench 10-teardown_group-bench.cpp -pthread && ./10-teardown_group-bench
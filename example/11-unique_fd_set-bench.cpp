@@ -0,0 +1,76 @@
+#include "nonstd/scope/unique_fd.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using namespace nonstd;
+
+// Worker recycling: a worker owns many descriptors, and closes them all at once;
+// each descriptor via its own unique_fd, versus via unique_fd_set's close_range().
+
+namespace {
+
+typedef std::chrono::steady_clock clock_type;
+
+int const fds_per_worker = 10000;
+int const rounds = 50;
+
+// Open a worker's descriptors, and return the time it takes to close them:
+
+clock_type::duration recycle_unique_fd()
+{
+    std::vector<unique_fd> fds;
+    fds.reserve( fds_per_worker );
+
+    for ( int i = 0; i < fds_per_worker; ++i )
+        fds.emplace_back( ::open( "/dev/null", O_RDONLY ) );
+
+    auto const start = clock_type::now();
+    fds.clear();
+    return clock_type::now() - start;
+}
+
+clock_type::duration recycle_unique_fd_set( std::size_t & calls )
+{
+    unique_fd_set fds;
+    fds.reserve( fds_per_worker );
+
+    for ( int i = 0; i < fds_per_worker; ++i )
+        fds.insert( ::open( "/dev/null", O_RDONLY ) );
+
+    auto const start = clock_type::now();
+    calls += fds.close_all();
+    return clock_type::now() - start;
+}
+
+} // anonymous namespace
+
+int main()
+{
+    std::size_t calls = 0;
+    clock_type::duration single_total{};
+    clock_type::duration set_total{};
+
+    // Alternate, so that both see the same state of the descriptor table:
+
+    for ( int r = 0; r < rounds; ++r )
+    {
+        single_total += recycle_unique_fd();
+        set_total    += recycle_unique_fd_set( calls );
+    }
+
+    double const single_time = std::chrono::duration<double>( single_total ).count();
+    double const set_time    = std::chrono::duration<double>( set_total ).count();
+
+    int const n = fds_per_worker * rounds;
+
+    std::cout << "close_range available : " << ( unique_fd_set::has_close_range() ? "yes" : "no (close() fallback)" ) << "\n"
+        << "unique_fd, close()    : " << single_time << " s, " << 1e9 * single_time / n << " ns/fd, " << n << " system calls\n"
+        << "unique_fd_set         : " << set_time    << " s, " << 1e9 * set_time    / n << " ns/fd, " << calls << " system calls\n";
+}
+
+// g++ -std=c++11 -O2 -Wall -I../include -o 11-unique_fd_set-bench 11-unique_fd_set-bench.cpp && ./11-unique_fd_set-bench
@@ -0,0 +1,112 @@
+#include "nonstd/scope/unique_mapping.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+using namespace nonstd;
+
+// Read throughput: checksum a file in the page cache via fread() into a buffer,
+// versus via a unique_mapping, plain and with MAP_POPULATE and sequential advice.
+
+namespace {
+
+typedef std::chrono::steady_clock clock_type;
+
+std::size_t const file_size   = 256u * 1024u * 1024u;
+std::size_t const buffer_size = 1024u * 1024u;
+int const rounds = 5;
+
+std::uint64_t checksum( unsigned char const * p, std::size_t n )
+{
+    std::uint64_t sum = 0;
+
+    for ( std::size_t i = 0; i + sizeof( sum ) <= n; i += sizeof( sum ) )
+    {
+        std::uint64_t word;
+        std::memcpy( &word, p + i, sizeof( word ) );
+        sum += word;
+    }
+    return sum;
+}
+
+std::uint64_t read_fread( char const * path )
+{
+    std::FILE * fp = std::fopen( path, "rb" );
+    auto closer = make_scope_exit( [fp]{ std::fclose( fp ); } );
+
+    std::vector<unsigned char> buffer( buffer_size );
+    std::uint64_t sum = 0;
+
+    for ( std::size_t n; ( n = std::fread( buffer.data(), 1, buffer.size(), fp ) ) > 0; )
+        sum += checksum( buffer.data(), n );
+
+    return sum;
+}
+
+std::uint64_t read_mapping( char const * path, unsigned options )
+{
+    auto fd = make_unique_resource_checked( ::open( path, O_RDONLY ), -1, ::close );
+    unique_mapping m = make_file_mapping( fd.get(), 0, PROT_READ, options );
+
+    return checksum( m.data(), m.size() );
+}
+
+template< class Read >
+double measure( Read read, std::uint64_t & sum )
+{
+    auto const start = clock_type::now();
+
+    for ( int r = 0; r < rounds; ++r )
+        sum += read();
+
+    return std::chrono::duration<double>( clock_type::now() - start ).count();
+}
+
+} // anonymous namespace
+
+int main()
+{
+    char path[] = "/tmp/scope-lite-mapping-bench-XXXXXX";
+    int const fd = ::mkstemp( path );
+    auto remover = make_scope_exit( [&]{ ::unlink( path ); } );
+
+    // scope:
+    {
+        auto closer = make_scope_exit( [fd]{ ::close( fd ); } );
+        std::vector<unsigned char> block( buffer_size );
+
+        for ( std::size_t i = 0; i < block.size(); ++i )
+            block[ i ] = static_cast<unsigned char>( i * 131 );
+
+        for ( std::size_t written = 0; written < file_size; written += block.size() )
+        {
+            if ( ::write( fd, block.data(), block.size() ) != static_cast<ssize_t>( block.size() ) )
+                return 1;
+        }
+    }
+
+    std::uint64_t sum = 0;
+
+    read_fread( path );     // page cache warm-up
+
+    double const fread_time     = measure( [&]{ return read_fread( path ); }, sum );
+    double const mapping_time   = measure( [&]{ return read_mapping( path, 0 ); }, sum );
+    double const populated_time = measure( [&]{ return read_mapping( path,
+        unique_mapping::map_populate | unique_mapping::advise_sequential ); }, sum );
+
+    double const gib = double( file_size ) * rounds / ( 1024.0 * 1024.0 * 1024.0 );
+
+    std::cout << "fread, 1 MiB buffer           : " << gib / fread_time     << " GiB/s\n"
+        << "unique_mapping                : " << gib / mapping_time   << " GiB/s\n"
+        << "unique_mapping, populate + seq: " << gib / populated_time << " GiB/s\n"
+        << "(checksum " << sum << ")\n";
+}
+
+// g++ -std=c++11 -O2 -Wall -I../include -o 12-unique_mapping-bench 12-unique_mapping-bench.cpp && ./12-unique_mapping-bench
@@ -0,0 +1,86 @@
+#include "nonstd/scope/unique_dirfd.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace nonstd;
+
+// Segment files in a deep directory: open and close each file via its absolute
+// path, versus via its name relative to a unique_dirfd of the directory.
+
+namespace {
+
+typedef std::chrono::steady_clock clock_type;
+
+int const files  = 1000;
+int const rounds = 200;
+
+double open_absolute( std::vector<std::string> const & paths )
+{
+    auto const start = clock_type::now();
+
+    for ( int r = 0; r < rounds; ++r )
+    {
+        for ( auto const & path : paths )
+            unique_fd fd( ::open( path.c_str(), O_RDONLY | O_CLOEXEC ) );
+    }
+
+    return std::chrono::duration<double>( clock_type::now() - start ).count();
+}
+
+double open_relative( unique_dirfd const & dir, std::vector<std::string> const & names )
+{
+    auto const start = clock_type::now();
+
+    for ( int r = 0; r < rounds; ++r )
+    {
+        for ( auto const & name : names )
+            unique_fd fd = dir.open( name.c_str(), O_RDONLY | O_CLOEXEC );
+    }
+
+    return std::chrono::duration<double>( clock_type::now() - start ).count();
+}
+
+} // anonymous namespace
+
+int main()
+{
+    char templ[] = "/tmp/scope-lite-dirfd-bench-XXXXXX";
+    std::string const root = ::mkdtemp( templ );
+    auto remover = make_scope_exit( [&]{ (void) std::system( ( "rm -rf " + root ).c_str() ); } );
+
+    unique_dirfd dir = open_directory( root.c_str() );
+    std::string path = root;
+
+    for ( char const * level : { "storage", "tables", "orders", "partition-2025", "shard-07", "segments" } )
+    {
+        dir  = dir.make_directory( level );
+        path = path + "/" + level;
+    }
+
+    std::vector<std::string> names;
+    std::vector<std::string> paths;
+
+    for ( int i = 0; i < files; ++i )
+    {
+        names.push_back( "segment-" + std::to_string( i ) );
+        paths.push_back( path + "/" + names.back() );
+        dir.open( names.back().c_str(), O_WRONLY | O_CREAT | O_CLOEXEC, 0600 );
+    }
+
+    double const absolute_time = open_absolute( paths );
+    double const relative_time = open_relative( dir, names );
+
+    int const n = files * rounds;
+
+    std::cout << "open(), absolute path       : " << 1e9 * absolute_time / n << " ns/file\n"
+        << "unique_dirfd::open(), name : " << 1e9 * relative_time / n << " ns/file\n";
+}
+
+// g++ -std=c++11 -O2 -Wall -I../include -o 13-unique_dirfd-bench 13-unique_dirfd-bench.cpp && ./13-unique_dirfd-bench
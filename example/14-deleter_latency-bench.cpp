@@ -0,0 +1,75 @@
+// Install deleter_latency_hooks for this program; a tweak header would do the same:
+
+namespace nonstd { namespace scope { struct deleter_latency_hooks; } }
+#define scope_CONFIG_HOOKS  ::nonstd::scope::deleter_latency_hooks
+
+#include "nonstd/scope/deleter_latency.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <climits>
+#include <iostream>
+
+using namespace nonstd;
+
+// Duplicate and close a descriptor via unique_resource, with every close() timed,
+// 1 in 64 timed, and practically none timed, to show the overhead of the hooks.
+
+namespace {
+
+typedef std::chrono::steady_clock clock_type;
+
+int const calls  = 200000;
+int const rounds = 5;
+
+struct close_deleter
+{
+    void operator()( int fd ) const
+    {
+        ::close( fd );
+    }
+};
+
+double dup_and_close( int fd, unsigned sampling )
+{
+    deleter_latency::set_sampling( sampling );
+
+    auto const start = clock_type::now();
+
+    for ( int i = 0; i < calls; ++i )
+        auto r = make_unique_resource_checked( ::dup( fd ), -1, close_deleter() );
+
+    return std::chrono::duration<double>( clock_type::now() - start ).count();
+}
+
+} // anonymous namespace
+
+int main()
+{
+    int const fd = ::open( "/dev/null", O_RDONLY | O_CLOEXEC );
+
+    double none = 0, all = 0, some = 0;
+
+    // Alternate the variants per round, to not favour one of them:
+
+    for ( int r = 0; r < rounds; ++r )
+    {
+        none += dup_and_close( fd, UINT_MAX );
+        all  += dup_and_close( fd, 1 );
+        some += dup_and_close( fd, 64 );
+    }
+
+    ::close( fd );
+
+    int const n = calls * rounds;
+
+    std::cout << "dup() + close(), none timed   : " << 1e9 * none / n << " ns\n"
+        << "dup() + close(), all timed    : " << 1e9 * all  / n << " ns (" << 100 * ( all  - none ) / none << "%)\n"
+        << "dup() + close(), 1 in 64 timed: " << 1e9 * some / n << " ns (" << 100 * ( some - none ) / none << "%)\n\n";
+
+    deleter_latency::dump( std::cout );
+}
+
+// g++ -std=c++11 -O2 -Wall -I../include -o 14-deleter_latency-bench 14-deleter_latency-bench.cpp && ./14-deleter_latency-bench
@@ -53,6 +53,10 @@
 # define scope_CONFIG_NO_CONSTEXPR  (scope_CONFIG_NO_EXTENSIONS || !scope_CPP20_OR_GREATER)
 #endif
 
+#if !defined( scope_CONFIG_HOOKS )
+# define scope_CONFIG_HOOKS  ::nonstd::scope::no_hooks
+#endif
+
 // C++ language version detection (C++23 is speculative):
 // Note: VC14.0/1900 (VS2015) lacks too much from C++14.
 
@@ -324,6 +328,10 @@ namespace nonstd
 
 #define scope_USE_POST_CPP98_VERSION  scope_CPP11_100
 
+// Hooks, see scope_CONFIG_HOOKS, are available with the post-C++98 version:
+
+#define scope_HAVE_HOOKS  scope_USE_POST_CPP98_VERSION
+
 // Additional includes:
 
 #include <exception>    // exception, terminate(), uncaught_exceptions()
@@ -693,6 +701,109 @@ T const & conditional_move( T && t, std11::false_type )
 // {
 // };
 
+// no_hooks: the default hook policy, see scope_CONFIG_HOOKS; it does nothing and compiles away.
+//
+// A hook policy receives the events of scope_exit, scope_fail, scope_success and unique_resource:
+// - on_construct( x ): a guard is constructed, or a unique_resource takes ownership of a resource,
+// - on_release( x ): release() is called, of a unique_resource only while it owns a resource,
+// - before_exit( x ), after_exit( x, token ): around the call of the exit function of a guard,
+// - before_delete( x ), after_delete( x, token ): around the call of the deleter of a unique_resource,
+// where after_*() receives the token that before_*() returned, e.g. a timestamp. Moving a guard
+// or a unique_resource is not an event. Hooks must not throw.
+
+struct no_hooks
+{
+    struct token {};
+
+    template< class T >
+    static scope_constexpr_ext void on_construct( T const & ) scope_noexcept {}
+
+    template< class T >
+    static scope_constexpr_ext void on_release( T const & ) scope_noexcept {}
+
+    template< class T >
+    static scope_constexpr_ext token before_exit( T const & ) scope_noexcept { return token(); }
+
+    template< class T >
+    static scope_constexpr_ext void after_exit( T const &, token ) scope_noexcept {}
+
+    template< class T >
+    static scope_constexpr_ext token before_delete( T const & ) scope_noexcept { return token(); }
+
+    template< class T >
+    static scope_constexpr_ext void after_delete( T const &, token ) scope_noexcept {}
+};
+
+// compose_hooks<A, B>: a hook policy that passes each event to policies A and B, as
+// scope_CONFIG_HOOKS names one policy. The before_*() and after_*() hooks of B run
+// within those of A, so a policy that times the exit function or deleter belongs in B.
+
+template< class A, class B >
+struct compose_hooks
+{
+    template< class TA, class TB >
+    struct token
+    {
+        TA a;
+        TB b;
+    };
+
+    template< class T >
+    static scope_constexpr_ext void on_construct( T const & x ) scope_noexcept
+    {
+        A::on_construct( x );
+        B::on_construct( x );
+    }
+
+    template< class T >
+    static scope_constexpr_ext void on_release( T const & x ) scope_noexcept
+    {
+        A::on_release( x );
+        B::on_release( x );
+    }
+
+    template< class T >
+    static scope_constexpr_ext auto before_exit( T const & x ) scope_noexcept
+        -> token< decltype( A::before_exit( x ) ), decltype( B::before_exit( x ) ) >
+    {
+        return { A::before_exit( x ), B::before_exit( x ) };
+    }
+
+    template< class T, class Token >
+    static scope_constexpr_ext void after_exit( T const & x, Token const & t ) scope_noexcept
+    {
+        B::after_exit( x, t.b );
+        A::after_exit( x, t.a );
+    }
+
+    template< class T >
+    static scope_constexpr_ext auto before_delete( T const & x ) scope_noexcept
+        -> token< decltype( A::before_delete( x ) ), decltype( B::before_delete( x ) ) >
+    {
+        return { A::before_delete( x ), B::before_delete( x ) };
+    }
+
+    template< class T, class Token >
+    static scope_constexpr_ext void after_delete( T const & x, Token const & t ) scope_noexcept
+    {
+        B::after_delete( x, t.b );
+        A::after_delete( x, t.a );
+    }
+};
+
+namespace detail {
+
+// The hook policy is looked up on instantiation, so that scope_CONFIG_HOOKS may name
+// a policy that is only declared before this header, e.g. in the tweak header:
+
+template< class T >
+struct hooks_of
+{
+    typedef scope_CONFIG_HOOKS type;
+};
+
+} // namespace detail
+
 // scope_exit:
 
 template< class EF >
@@ -716,7 +827,9 @@ public:
             conditional_forward<Fn>( std::forward<Fn>(fn)
                 , std11::bool_constant< std11::is_nothrow_constructible<EF, Fn>::value >() ) )
         , execute_on_destruction( true )
-    {}
+    {
+        detail::hooks_of<EF>::type::on_construct( *this );
+    }
 
     scope_constexpr_ext scope_exit( scope_exit && other )
     scope_noexcept_op
@@ -727,17 +840,22 @@ public:
         : exit_function( std::forward<EF>( other.exit_function ) )
         , execute_on_destruction( other.execute_on_destruction )
     {
-        other.release();
+        other.execute_on_destruction = false;
     }
 
     scope_constexpr_ext ~scope_exit() scope_noexcept
     {
         if ( execute_on_destruction )
+        {
+            auto const token = detail::hooks_of<EF>::type::before_exit( *this );
             exit_function();
+            detail::hooks_of<EF>::type::after_exit( *this, token );
+        }
     }
 
     scope_constexpr_ext void release() scope_noexcept
     {
+        detail::hooks_of<EF>::type::on_release( *this );
         execute_on_destruction = false;
     }
 
@@ -774,7 +892,9 @@ public:
             conditional_forward<Fn>( std::forward<Fn>(fn)
             , std11::bool_constant< std11::is_nothrow_constructible<EF, Fn>::value >() ) )
         , uncaught_on_creation( detail::uncaught_exceptions() )
-    {}
+    {
+        detail::hooks_of<EF>::type::on_construct( *this );
+    }
 
     scope_constexpr_ext scope_fail( scope_fail && other )
     scope_noexcept_op
@@ -785,17 +905,22 @@ public:
         : exit_function( std::forward<EF>( other.exit_function ) )
         , uncaught_on_creation( other.uncaught_on_creation )
     {
-        other.release();
+        other.uncaught_on_creation = std::numeric_limits<int>::max();
     }
 
     scope_constexpr_ext ~scope_fail() scope_noexcept
     {
         if ( uncaught_on_creation < detail::uncaught_exceptions() )
+        {
+            auto const token = detail::hooks_of<EF>::type::before_exit( *this );
             exit_function();
+            detail::hooks_of<EF>::type::after_exit( *this, token );
+        }
     }
 
     scope_constexpr_ext void release() scope_noexcept
     {
+        detail::hooks_of<EF>::type::on_release( *this );
         uncaught_on_creation = std::numeric_limits<int>::max();
     }
 
@@ -832,7 +957,9 @@ public:
             conditional_forward<Fn>( std::forward<Fn>(fn)
             , std11::bool_constant< std11::is_nothrow_constructible<EF, Fn>::value >() ) )
         , uncaught_on_creation( detail::uncaught_exceptions() )
-    {}
+    {
+        detail::hooks_of<EF>::type::on_construct( *this );
+    }
 
     scope_constexpr_ext scope_success( scope_success && other )
     scope_noexcept_op
@@ -843,7 +970,7 @@ public:
         : exit_function( std::forward<EF>( other.exit_function ) )
         , uncaught_on_creation( other.uncaught_on_creation )
     {
-        other.release();
+        other.uncaught_on_creation = -1;
     }
 
     scope_constexpr_ext ~scope_success()
@@ -852,11 +979,16 @@ public:
 #endif
     {
         if ( uncaught_on_creation >= detail::uncaught_exceptions() )
+        {
+            auto const token = detail::hooks_of<EF>::type::before_exit( *this );
             exit_function();
+            detail::hooks_of<EF>::type::after_exit( *this, token );
+        }
     }
 
     scope_constexpr_ext void release() scope_noexcept
     {
+        detail::hooks_of<EF>::type::on_release( *this );
         uncaught_on_creation = -1;
     }
 
@@ -973,7 +1105,10 @@ public:
         , deleter( ( conditional_forward<DD>( std::forward<DD>(d)
             , std11::bool_constant< std11::is_nothrow_constructible<D, DD>::value >() ) ) )
         , execute_on_reset( execute )
-    {}
+    {
+        if ( execute_on_reset )
+            detail::hooks_of<R>::type::on_construct( *this );
+    }
 
     // Move constructor.
     //
@@ -1004,8 +1139,10 @@ public:
     {
         if ( other.execute_on_reset && std11::is_nothrow_move_constructible<R>::value )
         {
+            other.execute_on_reset = false;
+            auto const token = detail::hooks_of<R>::type::before_delete( other );
             other.get_deleter()( this->get() );
-            other.release();
+            detail::hooks_of<R>::type::after_delete( other, token );
         }
     }
 
@@ -1075,7 +1212,9 @@ public:
         if ( execute_on_reset )
         {
             execute_on_reset = false;
+            auto const token = detail::hooks_of<R>::type::before_delete( *this );
             get_deleter()( get() );
+            detail::hooks_of<R>::type::after_delete( *this, token );
         }
     }
 
@@ -1083,12 +1222,21 @@ public:
     void reset( RR && r )
 #if scope_CPP11_110
     {
-        auto && guard = make_scope_fail( [&, this]{ get_deleter()(r); } ); // -Wunused-variable on clang
+        // Not via a scope_fail guard, which would report to the hook policy:
 
-        reset();
-        resource = conditional_forward<RR>( std::forward<RR>(r)
-            , std11::bool_constant< std11::is_nothrow_assignable<R1, RR>::value >() );
+        try
+        {
+            reset();
+            resource = conditional_forward<RR>( std::forward<RR>(r)
+                , std11::bool_constant< std11::is_nothrow_assignable<R1, RR>::value >() );
+        }
+        catch(...)
+        {
+            get_deleter()(r);
+            throw;
+        }
         execute_on_reset = true;
+        detail::hooks_of<R>::type::on_construct( *this );
     }
 #else // scope_CPP11_110
     try
@@ -1097,6 +1245,7 @@ public:
         resource = conditional_forward<RR>( std::forward<RR>(r)
             , std11::bool_constant< std11::is_nothrow_assignable<R1, RR>::value >() );
         execute_on_reset = true;
+        detail::hooks_of<R>::type::on_construct( *this );
     }
     catch(...)
     {
@@ -1106,6 +1255,8 @@ public:
 
     void release() scope_noexcept
     {
+        if ( execute_on_reset )
+            detail::hooks_of<R>::type::on_release( *this );
         execute_on_reset = false;
     }
 
@@ -0,0 +1,281 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Non-standard extension: acquire_all(), acquire several resources concurrently,
+// all or nothing.
+
+#ifndef NONSTD_SCOPE_ACQUIRE_ALL_HPP
+#define NONSTD_SCOPE_ACQUIRE_ALL_HPP
+
+#include "../scope.hpp"
+
+#define scope_HAVE_ACQUIRE_ALL  ( scope_CPP11_OR_GREATER && !scope_CONFIG_NO_EXTENSIONS )
+
+// Maximum number of threads, including the calling thread, that acquire_all() uses:
+
+#ifndef  scope_CONFIG_ACQUIRE_ALL_MAX_THREADS
+# define scope_CONFIG_ACQUIRE_ALL_MAX_THREADS  4
+#endif
+
+#if scope_HAVE_ACQUIRE_ALL
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace nonstd {
+namespace scope {
+
+// Thrown by acquire_all() when a checked acquisition yields its invalid value:
+
+class acquisition_error : public std::runtime_error
+{
+public:
+    explicit acquisition_error( std::size_t i )
+        : std::runtime_error( "acquire_all: acquisition " + std::to_string( i ) + " returned the invalid value" )
+        , position( i )
+    {}
+
+    // Position of the failed acquisition in the argument list:
+
+    std::size_t index() const noexcept
+    {
+        return position;
+    }
+
+private:
+    std::size_t position;
+};
+
+// checked_acquisition: acquire via factory F, like make_unique_resource_checked( f(), invalid, d ).
+
+template< class F, class S, class D >
+struct checked_acquisition
+{
+    F factory;
+    S invalid;
+    D deleter;
+};
+
+template< class F, class S, class D >
+checked_acquisition<typename std::decay<F>::type, typename std::decay<S>::type, typename std::decay<D>::type>
+make_checked_acquisition( F && f, S && invalid, D && d )
+{
+    return { std::forward<F>( f ), std::forward<S>( invalid ), std::forward<D>( d ) };
+}
+
+namespace detail {
+
+// The resource type an acquisition yields:
+
+template< class A >
+struct acquired
+{
+    typedef typename std::decay<decltype( std::declval<A &>()() )>::type type;
+};
+
+template< class F, class S, class D >
+struct acquired< checked_acquisition<F, S, D> >
+{
+    typedef unique_resource<typename std::decay<decltype( std::declval<F &>()() )>::type, D> type;
+};
+
+// Storage for one acquired resource; destroying it releases the resource:
+
+template< class T >
+class acquired_slot
+{
+public:
+    acquired_slot()
+        : filled( false )
+        , invalid( false )
+    {}
+
+    ~acquired_slot()
+    {
+        if ( filled )
+            get().~T();
+    }
+
+    template< class A >
+    void acquire( A & a ) noexcept
+    {
+        try
+        {
+            ::new( static_cast<void *>( storage ) ) T( a() );
+            filled = true;
+        }
+        catch ( ... )
+        {
+            error = std::current_exception();
+        }
+    }
+
+    template< class F, class S, class D >
+    void acquire( checked_acquisition<F, S, D> & a ) noexcept
+    {
+        try
+        {
+            auto r = a.factory();
+
+            if ( r == a.invalid )
+            {
+                invalid = true;
+                return;
+            }
+
+            ::new( static_cast<void *>( storage ) ) T( std::move( r ), a.deleter );
+            filled = true;
+        }
+        catch ( ... )
+        {
+            error = std::current_exception();
+        }
+    }
+
+    // Rethrow the failure of the acquisition at position i, if any:
+
+    void check( std::size_t i ) const
+    {
+        if ( error )
+            std::rethrow_exception( error );
+
+        if ( invalid )
+            throw acquisition_error( i );
+    }
+
+    T & get() noexcept
+    {
+        return *reinterpret_cast<T *>( storage );
+    }
+
+    acquired_slot( acquired_slot const & ) = delete;
+    acquired_slot & operator=( acquired_slot const & ) = delete;
+
+private:
+    alignas( T ) unsigned char storage[ sizeof( T ) ];
+    bool filled;
+    bool invalid;
+    std::exception_ptr error;
+};
+
+template< std::size_t... I >
+struct index_sequence {};
+
+template< std::size_t N, std::size_t... I >
+struct make_index_sequence : make_index_sequence<N - 1, N - 1, I...> {};
+
+template< std::size_t... I >
+struct make_index_sequence<0, I...> : index_sequence<I...> {};
+
+template< class... A >
+class acquire_all_task
+{
+public:
+    typedef std::tuple<typename acquired<A>::type...> result_type;
+
+    template< class... B >
+    explicit acquire_all_task( B &&... b )
+        : acquisitions( std::forward<B>( b )... )
+        , next( 0 )
+    {}
+
+    result_type run()
+    {
+        return run( make_index_sequence<sizeof...( A )>() );
+    }
+
+private:
+    template< std::size_t... I >
+    result_type run( index_sequence<I...> )
+    {
+        typedef void (*step)( acquire_all_task & );
+        step const steps[] = { &acquire_one<I>... };
+
+        std::size_t const n = sizeof...( A );
+        std::size_t const threads = n < scope_CONFIG_ACQUIRE_ALL_MAX_THREADS ? n : scope_CONFIG_ACQUIRE_ALL_MAX_THREADS;
+
+        auto work = [&]
+        {
+            for ( std::size_t i; ( i = next.fetch_add( 1, std::memory_order_relaxed ) ) < n; )
+                steps[ i ]( *this );
+        };
+
+        std::vector<std::thread> helpers;
+
+        // Without helpers, the calling thread acquires the rest:
+
+        try
+        {
+            for ( std::size_t t = 1; t < threads; ++t )
+                helpers.emplace_back( work );
+        }
+        catch ( std::exception const & ) {}
+
+        work();
+
+        for ( auto & h : helpers )
+            h.join();
+
+        // On failure, the slots release the acquired resources as they go out of scope:
+
+        int const checks[] = { ( std::get<I>( slots ).check( I ), 0 )... };
+        (void) checks;
+
+        return result_type( std::move( std::get<I>( slots ).get() )... );
+    }
+
+    template< std::size_t I >
+    static void acquire_one( acquire_all_task & self ) noexcept
+    {
+        std::get<I>( self.slots ).acquire( std::get<I>( self.acquisitions ) );
+    }
+
+    std::tuple<A...> acquisitions;
+    std::tuple<acquired_slot<typename acquired<A>::type>...> slots;
+    std::atomic<std::size_t> next;
+};
+
+} // namespace detail
+
+// acquire_all: run the acquisitions concurrently on up to scope_CONFIG_ACQUIRE_ALL_MAX_THREADS
+// threads, and return a tuple of the acquired resources.
+//
+// - an acquisition is a factory that returns a resource, such as a unique_resource,
+//   or a checked_acquisition that is invalid if its factory returns the invalid value,
+// - if any acquisition throws or is invalid, all acquired resources are released,
+//   and the failure of the first failed acquisition in argument order is thrown.
+
+template< class... A >
+std::tuple<typename detail::acquired<typename std::decay<A>::type>::type...>
+acquire_all( A &&... acquisitions )
+{
+    return detail::acquire_all_task<typename std::decay<A>::type...>( std::forward<A>( acquisitions )... ).run();
+}
+
+}} // namespace nonstd::scope
+
+namespace nonstd
+{
+    using scope::acquire_all;
+    using scope::acquisition_error;
+    using scope::checked_acquisition;
+    using scope::make_checked_acquisition;
+}
+
+#endif // scope_HAVE_ACQUIRE_ALL
+
+#endif // NONSTD_SCOPE_ACQUIRE_ALL_HPP
@@ -0,0 +1,534 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Non-standard extension: async_unique_resource and async scope guards, whose
+// deleter or exit function returns an awaitable, for C++20 coroutines.
+
+#ifndef NONSTD_SCOPE_ASYNC_UNIQUE_RESOURCE_HPP
+#define NONSTD_SCOPE_ASYNC_UNIQUE_RESOURCE_HPP
+
+#include "reclaimer.hpp"
+
+#if scope_CPP20_OR_GREATER && defined( __has_include )
+# if __has_include( <coroutine> ) && defined( __cpp_impl_coroutine )
+#  define scope_HAVE_COROUTINE  1
+# endif
+#endif
+
+#ifndef  scope_HAVE_COROUTINE
+# define scope_HAVE_COROUTINE  0
+#endif
+
+#define scope_HAVE_ASYNC_UNIQUE_RESOURCE  ( scope_HAVE_COROUTINE && scope_HAVE_RECLAIMER )
+
+#if scope_HAVE_ASYNC_UNIQUE_RESOURCE
+
+#include <coroutine>
+#include <exception>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace nonstd {
+namespace scope {
+
+// async_task: a lazy coroutine that starts when awaited, and resumes its awaiter
+// when it completes. An exception escaping the coroutine is rethrown to the awaiter.
+// Suitable as the return type of an asynchronous deleter or exit function.
+
+class [[nodiscard]] async_task
+{
+public:
+    struct promise_type
+    {
+        struct final_awaiter
+        {
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            std::coroutine_handle<> await_suspend( std::coroutine_handle<promise_type> h ) const noexcept
+            {
+                std::coroutine_handle<> const c = h.promise().continuation;
+                return c ? c : std::noop_coroutine();
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+        async_task get_return_object() noexcept
+        {
+            return async_task( std::coroutine_handle<promise_type>::from_promise( *this ) );
+        }
+
+        std::suspend_always initial_suspend() const noexcept
+        {
+            return {};
+        }
+
+        final_awaiter final_suspend() const noexcept
+        {
+            return {};
+        }
+
+        void return_void() const noexcept {}
+
+        void unhandled_exception() noexcept
+        {
+            error = std::current_exception();
+        }
+
+        std::coroutine_handle<> continuation;
+        std::exception_ptr error;
+    };
+
+    async_task( async_task && other ) noexcept
+        : handle( std::exchange( other.handle, nullptr ) )
+    {}
+
+    ~async_task()
+    {
+        if ( handle )
+            handle.destroy();
+    }
+
+    bool await_ready() const noexcept
+    {
+        return !handle || handle.done();
+    }
+
+    std::coroutine_handle<> await_suspend( std::coroutine_handle<> awaiter ) noexcept
+    {
+        handle.promise().continuation = awaiter;
+        return handle;
+    }
+
+    void await_resume() const
+    {
+        if ( handle && handle.promise().error )
+            std::rethrow_exception( handle.promise().error );
+    }
+
+    async_task( async_task const & ) = delete;
+    async_task & operator=( async_task const & ) = delete;
+    async_task & operator=( async_task && ) = delete;
+
+private:
+    explicit async_task( std::coroutine_handle<promise_type> h ) noexcept
+        : handle( h )
+    {}
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+namespace detail {
+
+// A coroutine that owns itself: it starts in the caller, and frees its frame when
+// it completes. An exception escaping it terminates the program. If its frame cannot
+// be allocated, it does not start and its handle is null.
+
+struct detached_task
+{
+    struct promise_type
+    {
+        detached_task get_return_object() noexcept
+        {
+            return detached_task{ std::coroutine_handle<promise_type>::from_promise( *this ) };
+        }
+
+        static detached_task get_return_object_on_allocation_failure() noexcept
+        {
+            return detached_task{ nullptr };
+        }
+
+        std::suspend_never initial_suspend() const noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never final_suspend() const noexcept
+        {
+            return {};
+        }
+
+        void return_void() const noexcept {}
+
+        void unhandled_exception() const noexcept
+        {
+            std::terminate();
+        }
+    };
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+// Suspend the awaiting coroutine and submit its resumption to an executor:
+
+template< class Executor >
+struct resume_on
+{
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    void await_suspend( std::coroutine_handle<> h ) const noexcept
+    {
+        executor.submit( [h]{ h.resume(); } );
+    }
+
+    void await_resume() const noexcept {}
+
+    Executor & executor;
+};
+
+// Take over the exit function, or the deleter and the resource, into the coroutine
+// frame before the first suspension; if the frame cannot be allocated, they are untouched:
+
+template< class Executor, class EF >
+detached_task await_detached( Executor & executor, EF & ef_ )
+{
+    EF ef( std::move( ef_ ) );
+
+    co_await resume_on<Executor>{ executor };
+    co_await ef();
+}
+
+template< class Executor, class D, class R >
+detached_task await_detached( Executor & executor, D & d_, R & r_ )
+{
+    D d( std::move( d_ ) );
+    R r( std::move( r_ ) );
+
+    co_await resume_on<Executor>{ executor };
+    co_await d( r );
+}
+
+// Await on this thread, without a coroutine frame. The awaitable must complete
+// without suspending, as nothing keeps it alive afterwards; if it does not, terminate.
+
+template< class Awaitable >
+decltype(auto) get_awaiter( Awaitable && a )
+{
+    if constexpr ( requires { std::forward<Awaitable>( a ).operator co_await(); } )
+        return std::forward<Awaitable>( a ).operator co_await();
+    else
+        return std::forward<Awaitable>( a );
+}
+
+template< class Awaitable >
+void await_inline( Awaitable && a ) noexcept
+{
+    auto && aw = get_awaiter( std::forward<Awaitable>( a ) );
+
+    if ( !aw.await_ready() )
+    {
+        using result = decltype( aw.await_suspend( std::noop_coroutine() ) );
+
+        bool resumed = false;
+
+        if constexpr ( std::is_void_v<result> )
+            aw.await_suspend( std::noop_coroutine() );
+        else if constexpr ( std::is_same_v<result, bool> )
+            resumed = !aw.await_suspend( std::noop_coroutine() );
+        else
+            aw.await_suspend( std::noop_coroutine() ).resume();
+
+        if ( !resumed && !aw.await_ready() )
+            std::terminate();
+    }
+
+    aw.await_resume();
+}
+
+// Run the exit function, or the deleter, in a detached coroutine resumed by the executor;
+// without memory for its frame, like reclaimer::submit(), run it on this thread:
+
+template< class Executor, class EF >
+void schedule( Executor & executor, EF & ef ) noexcept
+{
+    if ( !await_detached( executor, ef ).handle )
+        await_inline( ef() );
+}
+
+template< class Executor, class D, class R >
+void schedule( Executor & executor, D & d, R & r ) noexcept
+{
+    if ( !await_detached( executor, d, r ).handle )
+        await_inline( d( r ) );
+}
+
+} // namespace detail
+
+// async_unique_resource: like unique_resource, with a deleter D that returns an awaitable.
+//
+// - co_await async_reset() runs the deleter within the awaiting coroutine,
+// - when the resource is destroyed without async_reset(), it submits a coroutine that
+//   awaits the deleter to Executor, which must provide submit() of a nullary callable;
+//   the default executor is default_reclaimer().
+//
+// The fallback coroutine takes over the resource handle and the deleter.
+//
+// Unlike unique_resource, the constructor cannot await the deleter if taking over the
+// resource fails. It constructs the deleter first; if constructing the deleter or the
+// resource handle throws, the caller still owns the resource.
+
+template< class R, class D, class Executor = reclaimer >
+class async_unique_resource
+{
+public:
+    template< class RR, class DD >
+    async_unique_resource( RR && r, DD && d, Executor & ex = default_reclaimer() )
+        : deleter( std::forward<DD>( d ) )
+        , resource( std::forward<RR>( r ) )
+        , executor( &ex )
+        , execute_on_reset( true )
+    {}
+
+    async_unique_resource( async_unique_resource && other )
+        noexcept( std::is_nothrow_move_constructible<R>::value && std::is_nothrow_move_constructible<D>::value )
+        : deleter( std::move( other.deleter ) )
+        , resource( std::move( other.resource ) )
+        , executor( other.executor )
+        , execute_on_reset( std::exchange( other.execute_on_reset, false ) )
+    {}
+
+    ~async_unique_resource()
+    {
+        if ( execute_on_reset )
+            detail::schedule( *executor, deleter, resource );
+    }
+
+    async_task async_reset()
+    {
+        if ( execute_on_reset )
+        {
+            execute_on_reset = false;
+            co_await deleter( resource );
+        }
+    }
+
+    void release() noexcept
+    {
+        execute_on_reset = false;
+    }
+
+    R const & get() const noexcept
+    {
+        return resource;
+    }
+
+    D const & get_deleter() const noexcept
+    {
+        return deleter;
+    }
+
+    Executor & get_executor() const noexcept
+    {
+        return *executor;
+    }
+
+    async_unique_resource( async_unique_resource const & ) = delete;
+    async_unique_resource & operator=( async_unique_resource const & ) = delete;
+    async_unique_resource & operator=( async_unique_resource && ) = delete;
+
+private:
+    D deleter;
+    R resource;
+    Executor * executor;
+    bool execute_on_reset;
+};
+
+template< class RR, class DD >
+async_unique_resource( RR &&, DD && ) -> async_unique_resource<std::decay_t<RR>, std::decay_t<DD>>;
+
+template< class RR, class DD, class Executor >
+async_unique_resource( RR &&, DD &&, Executor & ) -> async_unique_resource<std::decay_t<RR>, std::decay_t<DD>, Executor>;
+
+// async_scope_exit: co_await async_execute() runs the exit function in the awaiting
+// coroutine; destruction without it submits the exit function to the executor.
+
+template< class EF, class Executor = reclaimer >
+class async_scope_exit
+{
+public:
+    template< class Fn >
+    explicit async_scope_exit( Fn && fn, Executor & ex = default_reclaimer() )
+        : exit_function( std::forward<Fn>( fn ) )
+        , executor( &ex )
+        , execute_on_destruction( true )
+    {}
+
+    async_scope_exit( async_scope_exit && other )
+        noexcept( std::is_nothrow_move_constructible<EF>::value )
+        : exit_function( std::move( other.exit_function ) )
+        , executor( other.executor )
+        , execute_on_destruction( std::exchange( other.execute_on_destruction, false ) )
+    {}
+
+    ~async_scope_exit()
+    {
+        if ( execute_on_destruction )
+            detail::schedule( *executor, exit_function );
+    }
+
+    async_task async_execute()
+    {
+        if ( execute_on_destruction )
+        {
+            execute_on_destruction = false;
+            co_await exit_function();
+        }
+    }
+
+    void release() noexcept
+    {
+        execute_on_destruction = false;
+    }
+
+    async_scope_exit( async_scope_exit const & ) = delete;
+    async_scope_exit & operator=( async_scope_exit const & ) = delete;
+    async_scope_exit & operator=( async_scope_exit && ) = delete;
+
+private:
+    EF exit_function;
+    Executor * executor;
+    bool execute_on_destruction;
+};
+
+// async_scope_fail: when the scope is left via an exception, the exit function
+// is submitted to the executor; a coroutine cannot await during stack unwinding.
+
+template< class EF, class Executor = reclaimer >
+class async_scope_fail
+{
+public:
+    template< class Fn >
+    explicit async_scope_fail( Fn && fn, Executor & ex = default_reclaimer() )
+        : exit_function( std::forward<Fn>( fn ) )
+        , executor( &ex )
+        , uncaught_on_creation( std::uncaught_exceptions() )
+    {}
+
+    async_scope_fail( async_scope_fail && other )
+        noexcept( std::is_nothrow_move_constructible<EF>::value )
+        : exit_function( std::move( other.exit_function ) )
+        , executor( other.executor )
+        , uncaught_on_creation( other.uncaught_on_creation )
+    {
+        other.release();
+    }
+
+    ~async_scope_fail()
+    {
+        if ( uncaught_on_creation < std::uncaught_exceptions() )
+            detail::schedule( *executor, exit_function );
+    }
+
+    void release() noexcept
+    {
+        uncaught_on_creation = std::numeric_limits<int>::max();
+    }
+
+    async_scope_fail( async_scope_fail const & ) = delete;
+    async_scope_fail & operator=( async_scope_fail const & ) = delete;
+    async_scope_fail & operator=( async_scope_fail && ) = delete;
+
+private:
+    EF exit_function;
+    Executor * executor;
+    int uncaught_on_creation;
+};
+
+// async_scope_success: co_await async_execute() at the end of the scope runs the exit
+// function in the awaiting coroutine; a scope left normally without it submits the
+// exit function to the executor, a scope left via an exception does not run it.
+
+template< class EF, class Executor = reclaimer >
+class async_scope_success
+{
+public:
+    template< class Fn >
+    explicit async_scope_success( Fn && fn, Executor & ex = default_reclaimer() )
+        : exit_function( std::forward<Fn>( fn ) )
+        , executor( &ex )
+        , uncaught_on_creation( std::uncaught_exceptions() )
+    {}
+
+    async_scope_success( async_scope_success && other )
+        noexcept( std::is_nothrow_move_constructible<EF>::value )
+        : exit_function( std::move( other.exit_function ) )
+        , executor( other.executor )
+        , uncaught_on_creation( other.uncaught_on_creation )
+    {
+        other.release();
+    }
+
+    ~async_scope_success()
+    {
+        if ( uncaught_on_creation >= std::uncaught_exceptions() )
+            detail::schedule( *executor, exit_function );
+    }
+
+    async_task async_execute()
+    {
+        if ( uncaught_on_creation != -1 )
+        {
+            release();
+            co_await exit_function();
+        }
+    }
+
+    void release() noexcept
+    {
+        uncaught_on_creation = -1;
+    }
+
+    async_scope_success( async_scope_success const & ) = delete;
+    async_scope_success & operator=( async_scope_success const & ) = delete;
+    async_scope_success & operator=( async_scope_success && ) = delete;
+
+private:
+    EF exit_function;
+    Executor * executor;
+    int uncaught_on_creation;
+};
+
+template< class Fn >
+async_scope_exit( Fn && ) -> async_scope_exit<std::decay_t<Fn>>;
+
+template< class Fn, class Executor >
+async_scope_exit( Fn &&, Executor & ) -> async_scope_exit<std::decay_t<Fn>, Executor>;
+
+template< class Fn >
+async_scope_fail( Fn && ) -> async_scope_fail<std::decay_t<Fn>>;
+
+template< class Fn, class Executor >
+async_scope_fail( Fn &&, Executor & ) -> async_scope_fail<std::decay_t<Fn>, Executor>;
+
+template< class Fn >
+async_scope_success( Fn && ) -> async_scope_success<std::decay_t<Fn>>;
+
+template< class Fn, class Executor >
+async_scope_success( Fn &&, Executor & ) -> async_scope_success<std::decay_t<Fn>, Executor>;
+
+}} // namespace nonstd::scope
+
+namespace nonstd
+{
+    using scope::async_task;
+    using scope::async_unique_resource;
+    using scope::async_scope_exit;
+    using scope::async_scope_fail;
+    using scope::async_scope_success;
+}
+
+#endif // scope_HAVE_ASYNC_UNIQUE_RESOURCE
+
+#endif // NONSTD_SCOPE_ASYNC_UNIQUE_RESOURCE_HPP
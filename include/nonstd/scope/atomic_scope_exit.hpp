@@ -0,0 +1,174 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Non-standard extension: atomic_scope_exit, a scope_exit that can be released
+// from another thread via a handle, racing the destructor on a single atomic exchange.
+
+#ifndef NONSTD_SCOPE_ATOMIC_SCOPE_EXIT_HPP
+#define NONSTD_SCOPE_ATOMIC_SCOPE_EXIT_HPP
+
+#include "../scope.hpp"
+
+#define scope_HAVE_ATOMIC_SCOPE_EXIT  ( scope_CPP11_OR_GREATER && !scope_CONFIG_NO_EXTENSIONS )
+
+#if scope_HAVE_ATOMIC_SCOPE_EXIT
+
+#include <atomic>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace nonstd {
+namespace scope {
+
+// atomic_release_handle: releases an atomic_scope_exit from another thread, also while
+// or after the guard is destroyed; it shares the guard's 'armed' flag, not the guard.
+// A default-constructed handle releases nothing.
+
+class atomic_release_handle
+{
+public:
+    atomic_release_handle() noexcept {}
+
+    // true if this call prevented the exit function from running:
+
+    bool try_release() noexcept
+    {
+        return armed && armed->exchange( false, std::memory_order_acq_rel );
+    }
+
+    void release() noexcept
+    {
+        try_release();
+    }
+
+private:
+    template< class EF > friend class atomic_scope_exit;
+
+    explicit atomic_release_handle( std::shared_ptr< std::atomic<bool> > armed_ ) noexcept
+        : armed( std::move( armed_ ) )
+    {}
+
+    std::shared_ptr< std::atomic<bool> > armed;
+};
+
+// atomic_scope_exit:
+//
+// release(), try_release(), try_execute(), the destructor and the handles from
+// release_handle() all take the 'armed' flag with one atomic exchange, so exactly one
+// of them wins without locking. Other threads may call the guard's members while it
+// lives; to race its destruction, they use a handle, which keeps the flag alive. The
+// flag moves to the heap on the first call of release_handle(), so a guard without
+// handles does not allocate.
+
+template< class EF >
+class atomic_scope_exit
+{
+public:
+    template< class Fn
+        , typename std::enable_if<
+            !std::is_same<typename std::decay<Fn>::type, atomic_scope_exit>::value
+            && std::is_constructible<EF, Fn>::value, int >::type = 0
+    >
+    explicit atomic_scope_exit( Fn && fn )
+        noexcept( std::is_nothrow_constructible<EF, Fn>::value )
+        : exit_function( std::forward<Fn>( fn ) )
+        , local_armed( true )
+        , shared_armed()
+    {}
+
+    // Moving may race with handles, which keep the flag; it is not meant to race with
+    // the members of other:
+
+    atomic_scope_exit( atomic_scope_exit && other )
+        noexcept( std::is_nothrow_move_constructible<EF>::value )
+        : exit_function( std::move( other.exit_function ) )
+        , local_armed( other.local_armed.exchange( false, std::memory_order_acq_rel ) )
+        , shared_armed( std::move( other.shared_armed ) )
+    {}
+
+    ~atomic_scope_exit()
+    {
+        try_execute();
+    }
+
+    // true if this call prevented the exit function from running:
+
+    bool try_release() noexcept
+    {
+        return armed().exchange( false, std::memory_order_acq_rel );
+    }
+
+    void release() noexcept
+    {
+        try_release();
+    }
+
+    // Run the exit function now, unless it already ran or was released;
+    // true if this call ran it:
+
+    bool try_execute()
+    {
+        if ( !armed().exchange( false, std::memory_order_acq_rel ) )
+            return false;
+
+        exit_function();
+        return true;
+    }
+
+    // A handle for another thread to release this guard; call it on the owning thread:
+
+    atomic_release_handle release_handle()
+    {
+        if ( !shared_armed )
+        {
+            shared_armed = std::make_shared< std::atomic<bool> >(
+                local_armed.exchange( false, std::memory_order_acq_rel ) );
+        }
+
+        return atomic_release_handle( shared_armed );
+    }
+
+    atomic_scope_exit( atomic_scope_exit const & ) = delete;
+    atomic_scope_exit & operator=( atomic_scope_exit const & ) = delete;
+    atomic_scope_exit & operator=( atomic_scope_exit && ) = delete;
+
+private:
+    std::atomic<bool> & armed() noexcept
+    {
+        return shared_armed ? *shared_armed : local_armed;
+    }
+
+    EF exit_function;
+    std::atomic<bool> local_armed;
+    std::shared_ptr< std::atomic<bool> > shared_armed;
+};
+
+#if scope_CPP17_OR_GREATER
+template< class EF > atomic_scope_exit(EF) -> atomic_scope_exit<EF>;
+#endif
+
+template< class EF >
+atomic_scope_exit<typename std::decay<EF>::type>
+make_atomic_scope_exit( EF && exit_function )
+{
+    return atomic_scope_exit<typename std::decay<EF>::type>( std::forward<EF>( exit_function ) );
+}
+
+}} // namespace nonstd::scope
+
+namespace nonstd
+{
+    using scope::atomic_release_handle;
+    using scope::atomic_scope_exit;
+    using scope::make_atomic_scope_exit;
+}
+
+#endif // scope_HAVE_ATOMIC_SCOPE_EXIT
+
+#endif // NONSTD_SCOPE_ATOMIC_SCOPE_EXIT_HPP
@@ -0,0 +1,348 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Non-standard extension: atomic_unique_resource, lock-free publication of a
+// unique_resource with hazard pointer protected readers.
+
+#ifndef NONSTD_SCOPE_ATOMIC_UNIQUE_RESOURCE_HPP
+#define NONSTD_SCOPE_ATOMIC_UNIQUE_RESOURCE_HPP
+
+#include "../scope.hpp"
+
+#define scope_HAVE_ATOMIC_UNIQUE_RESOURCE  ( scope_CPP11_OR_GREATER && !scope_CONFIG_NO_EXTENSIONS )
+
+#if scope_HAVE_ATOMIC_UNIQUE_RESOURCE
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace nonstd {
+namespace scope {
+
+// atomic_unique_resource:
+//
+// - load() yields a reader that keeps the current resource alive until the reader is destroyed,
+// - store() and exchange() publish a new resource and retire the previous one,
+// - a retired resource is deleted via its deleter once no reader refers to it.
+//
+// Readers must not outlive the atomic_unique_resource they were obtained from.
+
+template< class R, class D >
+class atomic_unique_resource
+{
+public:
+    typedef unique_resource<R, D> unique_resource_type;
+
+    // number of retired resources that triggers an attempt to reclaim them:
+
+    enum { reclaim_threshold = 64 };
+
+private:
+    struct node
+    {
+        explicit node( unique_resource_type && r )
+            : resource( std::move( r ) )
+            , next( nullptr )
+        {}
+
+        unique_resource_type resource;
+        node * next;    // link in the retired list
+    };
+
+    // A record is written by its reader on each access; the padding keeps the records
+    // of different readers on separate cache lines, also without aligned new before C++17:
+
+    struct hazard_record
+    {
+        hazard_record()
+            : hazard( nullptr )
+            , active( true )
+            , next( nullptr )
+        {}
+
+        char padding_before[64];
+        std::atomic<node const *> hazard;
+        std::atomic<bool> active;
+        hazard_record * next;   // immutable once published
+        char padding_after[64];
+    };
+
+public:
+    // reader: a hazard-protected reference to a published resource.
+
+    class reader
+    {
+    public:
+        reader( reader && other ) noexcept
+            : record( other.record )
+            , p( other.p )
+        {
+            other.record = nullptr;
+            other.p      = nullptr;
+        }
+
+        ~reader()
+        {
+            if ( record )
+            {
+                record->hazard.store( nullptr, std::memory_order_release );
+                record->active.store( false, std::memory_order_release );
+            }
+        }
+
+        auto get() const noexcept -> decltype( std::declval<unique_resource_type const &>().get() )
+        {
+            return p->resource.get();
+        }
+
+        template< class RR = R >
+        auto operator*() const noexcept ->
+            typename std::enable_if<
+                std::is_pointer<RR>::value && !std::is_void<typename std::remove_pointer<RR>::type>::value
+                , typename std::add_lvalue_reference<typename std::remove_pointer<RR>::type>::type
+            >::type
+        {
+            return *get();
+        }
+
+        template< class RR = R >
+        auto operator->() const noexcept -> typename std::enable_if< std::is_pointer<RR>::value, RR >::type
+        {
+            return get();
+        }
+
+        D const & get_deleter() const noexcept
+        {
+            return p->resource.get_deleter();
+        }
+
+        // false if there was no resource to read:
+
+        explicit operator bool() const noexcept
+        {
+            return p != nullptr;
+        }
+
+    private:
+        friend class atomic_unique_resource;
+
+        reader( hazard_record * rec, node const * q ) noexcept
+            : record( rec )
+            , p( q )
+        {}
+
+        reader & operator=( reader const & ) = delete;
+        reader( reader const & ) = delete;
+
+    private:
+        hazard_record * record;
+        node const * p;
+    };
+
+    atomic_unique_resource() noexcept
+        : current( nullptr )
+        , records( nullptr )
+        , retired( nullptr )
+        , retired_count( 0 )
+    {}
+
+    explicit atomic_unique_resource( unique_resource_type && r )
+        : current( new node( std::move( r ) ) )
+        , records( nullptr )
+        , retired( nullptr )
+        , retired_count( 0 )
+    {}
+
+    // Precondition: no reader is alive.
+
+    ~atomic_unique_resource()
+    {
+        delete current.load( std::memory_order_relaxed );
+
+        delete_list( retired.load( std::memory_order_relaxed ) );
+
+        for ( hazard_record * rec = records.load( std::memory_order_relaxed ); rec; )
+        {
+            hazard_record * next = rec->next;
+            delete rec;
+            rec = next;
+        }
+    }
+
+    reader load() const
+    {
+        hazard_record * rec = acquire_record();
+
+        node const * p = current.load( std::memory_order_relaxed );
+
+        for (;;)
+        {
+            rec->hazard.store( p, std::memory_order_seq_cst );
+
+            node const * q = current.load( std::memory_order_seq_cst );
+
+            if ( p == q )
+                return reader( rec, p );
+
+            p = q;
+        }
+    }
+
+    // Publish r and retire the previous resource:
+
+    void store( unique_resource_type && r )
+    {
+        node * n = new node( std::move( r ) );
+
+        retire( current.exchange( n, std::memory_order_seq_cst ) );
+    }
+
+    // Publish r and retire the previous resource; the returned reader keeps it alive:
+
+    reader exchange( unique_resource_type && r )
+    {
+        hazard_record * rec = acquire_record();
+        node * n = nullptr;
+
+        try
+        {
+            n = new node( std::move( r ) );
+        }
+        catch(...)
+        {
+            rec->active.store( false, std::memory_order_release );
+            throw;
+        }
+
+        // The old node is not retired yet, so no-one can delete it before it is protected:
+
+        node * old = current.exchange( n, std::memory_order_seq_cst );
+
+        rec->hazard.store( old, std::memory_order_seq_cst );
+
+        retire( old );
+
+        return reader( rec, old );
+    }
+
+    // Delete the retired resources that are no longer read:
+
+    void reclaim() noexcept
+    {
+        node * list = retired.exchange( nullptr, std::memory_order_acq_rel );
+
+        std::size_t deleted = 0;
+
+        while ( list )
+        {
+            node * next = list->next;
+
+            if ( is_hazard( list ) )
+            {
+                push_retired( list );
+            }
+            else
+            {
+                delete list;
+                ++deleted;
+            }
+
+            list = next;
+        }
+
+        retired_count.fetch_sub( deleted, std::memory_order_relaxed );
+    }
+
+    atomic_unique_resource( atomic_unique_resource const & ) = delete;
+    atomic_unique_resource & operator=( atomic_unique_resource const & ) = delete;
+
+private:
+    hazard_record * acquire_record() const
+    {
+        for ( hazard_record * rec = records.load( std::memory_order_acquire ); rec; rec = rec->next )
+        {
+            if ( !rec->active.load( std::memory_order_relaxed )
+                && !rec->active.exchange( true, std::memory_order_acquire ) )
+            {
+                return rec;
+            }
+        }
+
+        hazard_record * rec = new hazard_record;
+        hazard_record * head = records.load( std::memory_order_relaxed );
+
+        do
+        {
+            rec->next = head;
+        }
+        while ( !records.compare_exchange_weak( head, rec, std::memory_order_release, std::memory_order_relaxed ) );
+
+        return rec;
+    }
+
+    bool is_hazard( node const * p ) const noexcept
+    {
+        for ( hazard_record * rec = records.load( std::memory_order_acquire ); rec; rec = rec->next )
+        {
+            if ( rec->hazard.load( std::memory_order_seq_cst ) == p )
+                return true;
+        }
+        return false;
+    }
+
+    void push_retired( node * p ) noexcept
+    {
+        node * head = retired.load( std::memory_order_relaxed );
+
+        do
+        {
+            p->next = head;
+        }
+        while ( !retired.compare_exchange_weak( head, p, std::memory_order_release, std::memory_order_relaxed ) );
+    }
+
+    void retire( node * p ) noexcept
+    {
+        if ( !p )
+            return;
+
+        push_retired( p );
+
+        if ( retired_count.fetch_add( 1, std::memory_order_relaxed ) + 1 >= reclaim_threshold )
+            reclaim();
+    }
+
+    static void delete_list( node * list ) noexcept
+    {
+        while ( list )
+        {
+            node * next = list->next;
+            delete list;
+            list = next;
+        }
+    }
+
+private:
+    std::atomic<node *> current;
+    mutable std::atomic<hazard_record *> records;
+    std::atomic<node *> retired;
+    std::atomic<std::size_t> retired_count;
+};
+
+}} // namespace nonstd::scope
+
+namespace nonstd
+{
+    using scope::atomic_unique_resource;
+}
+
+#endif // scope_HAVE_ATOMIC_UNIQUE_RESOURCE
+
+#endif // NONSTD_SCOPE_ATOMIC_UNIQUE_RESOURCE_HPP
@@ -0,0 +1,336 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Non-standard extension: deferred_release_scope and deferrable, batch the
+// deleters and exit functions of a thread until its outermost scope ends.
+
+#ifndef NONSTD_SCOPE_DEFERRED_RELEASE_HPP
+#define NONSTD_SCOPE_DEFERRED_RELEASE_HPP
+
+#include "../scope.hpp"
+
+#define scope_HAVE_DEFERRED_RELEASE  ( scope_CPP11_OR_GREATER && !scope_CONFIG_NO_EXTENSIONS )
+
+#if scope_HAVE_DEFERRED_RELEASE
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace nonstd {
+namespace scope {
+
+namespace detail {
+
+// Per-thread FIFO of deferred actions, stored in chunks that are reused
+// from batch to batch, so a steady state does not allocate:
+
+class deferred_queue
+{
+public:
+    enum { chunk_size = 4096 };
+
+    static deferred_queue & instance() noexcept
+    {
+        thread_local deferred_queue queue;
+        return queue;
+    }
+
+    // Actions are only deferred within a scope, and not while a batch runs:
+
+    bool is_deferring() const noexcept
+    {
+        return depth > 0 && !running;
+    }
+
+    // false if the action cannot be stored; the caller then runs it:
+
+    template< class Fn >
+    bool push( Fn && fn ) noexcept
+    {
+        typedef typename std::decay<Fn>::type action;
+
+        std::size_t const need = round_up( sizeof( header ) ) + round_up( sizeof( action ) );
+
+        if ( need > chunk_size || alignof( action ) > alignof( std::max_align_t ) )
+            return false;
+
+        if ( !reserve( need ) )
+            return false;
+
+        unsigned char * p = current->data + current->used;
+
+        ::new( static_cast<void *>( p ) ) header( &invoke_and_destroy<action>, need );
+        ::new( static_cast<void *>( p + round_up( sizeof( header ) ) ) ) action( std::forward<Fn>( fn ) );
+
+        current->used += need;
+        ++count;
+        return true;
+    }
+
+    // Run and destroy all actions in order of deferral:
+
+    void run() noexcept
+    {
+        if ( running )
+            return;
+
+        running = true;
+
+        for ( chunk * c = first; c; c = c->next )
+        {
+            for ( std::size_t offset = 0; offset < c->used; )
+            {
+                header * h = reinterpret_cast<header *>( c->data + offset );
+                h->invoke( c->data + offset + round_up( sizeof( header ) ) );
+                offset += h->size;
+            }
+            c->used = 0;
+
+            if ( c == current )
+                break;
+        }
+
+        current = first;
+        count   = 0;
+        running = false;
+    }
+
+    std::size_t pending() const noexcept
+    {
+        return count;
+    }
+
+    // A deferred_release_scope begins and ends; true if it was the outermost one:
+
+    void enter() noexcept
+    {
+        ++depth;
+    }
+
+    bool leave() noexcept
+    {
+        return --depth == 0;
+    }
+
+    ~deferred_queue()
+    {
+        run();
+
+        while ( first )
+        {
+            chunk * next = first->next;
+            delete first;
+            first = next;
+        }
+    }
+
+private:
+    deferred_queue() noexcept
+        : depth( 0 )
+        , running( false )
+        , count( 0 )
+        , first( nullptr )
+        , current( nullptr )
+    {}
+
+    struct header
+    {
+        header( void (*f)( void * ), std::size_t n )
+            : invoke( f )
+            , size( n )
+        {}
+
+        void (*invoke)( void * );
+        std::size_t size;
+    };
+
+    struct chunk
+    {
+        chunk()
+            : next( nullptr )
+            , used( 0 )
+        {}
+
+        chunk * next;
+        std::size_t used;
+        alignas( std::max_align_t ) unsigned char data[ chunk_size ];
+    };
+
+    template< class Action >
+    static void invoke_and_destroy( void * p ) noexcept
+    {
+        Action * a = static_cast<Action *>( p );
+        (*a)();
+        a->~Action();
+    }
+
+    static std::size_t round_up( std::size_t n ) noexcept
+    {
+        return ( n + alignof( std::max_align_t ) - 1 ) / alignof( std::max_align_t ) * alignof( std::max_align_t );
+    }
+
+    bool reserve( std::size_t need ) noexcept
+    {
+        if ( current && current->used + need <= chunk_size )
+            return true;
+
+        chunk * next = current ? current->next : first;
+
+        if ( next == nullptr )
+        {
+            next = new( std::nothrow ) chunk;
+
+            if ( next == nullptr )
+                return false;
+
+            if ( current )
+                current->next = next;
+            else
+                first = next;
+        }
+
+        current = next;
+        return true;
+    }
+
+private:
+    int depth;
+    bool running;
+    std::size_t count;
+    chunk * first;
+    chunk * current;
+};
+
+} // namespace detail
+
+// deferred_release_scope: while one is alive on a thread, deferrable deleters and
+// exit functions of that thread are queued; the outermost scope runs them in one batch.
+
+class deferred_release_scope
+{
+public:
+    deferred_release_scope() noexcept
+    {
+        detail::deferred_queue::instance().enter();
+    }
+
+    ~deferred_release_scope()
+    {
+        detail::deferred_queue & q = detail::deferred_queue::instance();
+
+        if ( q.leave() )
+            q.run();
+    }
+
+    // Run the actions deferred so far, e.g. at a quiescent point within the scope:
+
+    static void flush() noexcept
+    {
+        detail::deferred_queue::instance().run();
+    }
+
+    static std::size_t pending() noexcept
+    {
+        return detail::deferred_queue::instance().pending();
+    }
+
+    static bool is_active() noexcept
+    {
+        return detail::deferred_queue::instance().is_deferring();
+    }
+
+    deferred_release_scope( deferred_release_scope const & ) = delete;
+    deferred_release_scope & operator=( deferred_release_scope const & ) = delete;
+};
+
+// deferrable: adapt a deleter or exit function to be deferred while a
+// deferred_release_scope is active, and to run immediately otherwise.
+//
+// A deferred call runs when the outermost scope ends, after the locals of inner scopes
+// are destroyed: an exit function must capture what it uses by value, not by reference,
+// unless it outlives that scope. The function is copied into the queue.
+
+template< class F >
+class deferrable
+{
+public:
+    deferrable()
+        : fn()
+    {}
+
+    explicit deferrable( F const & f )
+        : fn( f )
+    {}
+
+    explicit deferrable( F && f )
+        : fn( std::move( f ) )
+    {}
+
+    // as exit function:
+
+    void operator()() const
+    {
+        detail::deferred_queue & q = detail::deferred_queue::instance();
+
+        if ( q.is_deferring() && q.push( fn ) )
+            return;
+
+        fn();
+    }
+
+    // as deleter:
+
+    template< class R >
+    void operator()( R const & resource ) const
+    {
+        detail::deferred_queue & q = detail::deferred_queue::instance();
+
+        if ( q.is_deferring() )
+        {
+            F const f = fn;
+            R const r = resource;
+
+            if ( q.push( [f, r]{ f( r ); } ) )
+                return;
+        }
+
+        fn( resource );
+    }
+
+    F const & get_function() const noexcept
+    {
+        return fn;
+    }
+
+private:
+    F fn;
+};
+
+// Wrap f; see deferrable for what f may capture:
+
+template< class F >
+deferrable<typename std::decay<F>::type>
+make_deferrable( F && f )
+{
+    return deferrable<typename std::decay<F>::type>( std::forward<F>( f ) );
+}
+
+}} // namespace nonstd::scope
+
+namespace nonstd
+{
+    using scope::deferred_release_scope;
+    using scope::deferrable;
+    using scope::make_deferrable;
+}
+
+#endif // scope_HAVE_DEFERRED_RELEASE
+
+#endif // NONSTD_SCOPE_DEFERRED_RELEASE_HPP
@@ -0,0 +1,304 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Non-standard extension: deleter_latency_hooks, a hook policy that times the deleter
+// calls of unique_resource into per-thread log-linear histograms per resource type.
+
+#ifndef NONSTD_SCOPE_DELETER_LATENCY_HPP
+#define NONSTD_SCOPE_DELETER_LATENCY_HPP
+
+#include "latency_histogram.hpp"
+#include "type_name.hpp"
+
+#define scope_HAVE_DELETER_LATENCY  ( scope_HAVE_LATENCY_HISTOGRAM && scope_HAVE_HOOKS )
+
+#if scope_HAVE_DELETER_LATENCY
+
+#include "detail/thread_shards.hpp"
+
+// Time 1 in N deleter calls per thread and type; see deleter_latency::set_sampling():
+
+#ifndef  scope_CONFIG_DELETER_LATENCY_SAMPLING
+# define scope_CONFIG_DELETER_LATENCY_SAMPLING  1
+#endif
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace nonstd {
+namespace scope {
+
+namespace detail {
+
+// The histogram of one resource type, written by one thread and read by snapshots.
+// The padding keeps the histograms of different threads on separate cache lines:
+
+struct latency_shard
+{
+    latency_shard() noexcept
+    {
+        for ( auto & c : counts )
+            c.store( 0, std::memory_order_relaxed );
+    }
+
+    void add( std::uint64_t ticks ) noexcept
+    {
+        single_writer_increment( counts[ latency_histogram::bucket_of( ticks ) ] );
+    }
+
+    void add_to( latency_histogram & h ) const noexcept
+    {
+        for ( std::size_t i = 0; i < latency_histogram::bucket_count; ++i )
+        {
+            std::uint64_t const n = counts[ i ].load( std::memory_order_relaxed );
+
+            if ( n )
+                h.add( latency_histogram::lower_bound( i ), n );
+        }
+    }
+
+    char padding_before[64];
+    std::atomic<std::uint64_t> counts[ latency_histogram::bucket_count ];
+    char padding_after[64];
+};
+
+// One resource type: the shards of live threads, and the totals of threads that exited:
+
+class latency_type
+{
+public:
+    typedef latency_shard shard;
+
+    explicit latency_type( std::string name_ )
+        : name( std::move( name_ ) )
+    {}
+
+    latency_shard * add_shard()
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        live.push_back( std::unique_ptr<latency_shard>( new latency_shard() ) );
+        return live.back().get();
+    }
+
+    void retire( latency_shard const * shard ) noexcept
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+
+        for ( std::size_t i = 0; i < live.size(); ++i )
+        {
+            if ( live[ i ].get() == shard )
+            {
+                live[ i ]->add_to( retired );
+                live.erase( live.begin() + static_cast<std::ptrdiff_t>( i ) );
+                break;
+            }
+        }
+    }
+
+    // Count directly into the totals, for a thread whose shards are gone:
+
+    void add_retired( std::uint64_t ticks ) noexcept
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        retired.add( ticks );
+    }
+
+    latency_histogram snapshot() const
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        latency_histogram h = retired;
+
+        for ( auto const & shard : live )
+            shard->add_to( h );
+
+        return h;
+    }
+
+    std::string const name;
+
+private:
+    mutable std::mutex mutex;
+    latency_histogram retired;
+    std::vector< std::unique_ptr<latency_shard> > live;
+};
+
+typedef shard_registry<latency_type> latency_registry;
+
+template< class T >
+std::size_t latency_type_index()
+{
+    static std::size_t const index = latency_registry::instance().add_type( type_name<T>() );
+    return index;
+}
+
+template< class T >
+latency_type & latency_type_of()
+{
+    static latency_type & type = latency_registry::instance().type( latency_type_index<T>() );
+    return type;
+}
+
+inline std::atomic<unsigned> & latency_sampling() noexcept
+{
+    static std::atomic<unsigned> sampling( scope_CONFIG_DELETER_LATENCY_SAMPLING );
+    return sampling;
+}
+
+} // namespace detail
+
+// deleter_latency: the histograms that deleter_latency_hooks recorded.
+
+class deleter_latency
+{
+public:
+    // Time 1 in n deleter calls per thread and type, n >= 1:
+
+    static void set_sampling( unsigned n ) noexcept
+    {
+        detail::latency_sampling().store( n > 0 ? n : 1, std::memory_order_relaxed );
+    }
+
+    static unsigned sampling() noexcept
+    {
+        return detail::latency_sampling().load( std::memory_order_relaxed );
+    }
+
+    // Record a deleter call of a T that took ticks latency_clock ticks:
+
+    template< class T >
+    static void record( std::uint64_t ticks )
+    {
+        detail::latency_shard * shard = detail::thread_shards<detail::latency_type>::get( detail::latency_type_index<T>() );
+
+        if ( shard )
+            shard->add( ticks );
+        else
+            detail::latency_type_of<T>().add_retired( ticks );
+    }
+
+    // The histogram of type T, merged over all threads:
+
+    template< class T >
+    static latency_histogram snapshot()
+    {
+        return detail::latency_type_of<T>().snapshot();
+    }
+
+    // Call f( name, histogram ) for each type that was recorded:
+
+    template< class F >
+    static void for_each( F f )
+    {
+        detail::latency_registry::instance().for_each( [&f]( detail::latency_type const & type )
+        {
+            f( type.name, type.snapshot() );
+        } );
+    }
+
+    // Write a line with the count and the quantiles in nanoseconds per type,
+    // followed by its non-empty buckets:
+
+    static void dump( std::ostream & os )
+    {
+        os << "deleter latency, 1 in " << sampling() << " calls timed:\n";
+
+        for_each( [&os]( std::string const & name, latency_histogram const & h )
+        {
+            if ( h.count() == 0 )
+                return;
+
+            os << name << ": n=" << h.count()
+                << " p50=" << ns( h.quantile( 0.5 ) )
+                << " p90=" << ns( h.quantile( 0.9 ) )
+                << " p99=" << ns( h.quantile( 0.99 ) )
+                << " max=" << ns( h.quantile( 1.0 ) ) << "\n";
+
+            for ( std::size_t i = 0; i < latency_histogram::bucket_count; ++i )
+            {
+                if ( h.bucket( i ) )
+                {
+                    os << "  <= " << std::setw( 12 ) << ns( latency_histogram::upper_bound( i ) )
+                        << ": " << h.bucket( i ) << "\n";
+                }
+            }
+        } );
+    }
+
+private:
+    static std::string ns( std::uint64_t ticks )
+    {
+        return std::to_string( latency_clock::to_nanoseconds( ticks ) ) + "ns";
+    }
+};
+
+// deleter_latency_hooks: a hook policy, see scope_CONFIG_HOOKS, that times 1 in
+// deleter_latency::sampling() deleter calls of unique_resource per thread and type. To use it:
+//
+//   // nonstd/scope.tweak.hpp:
+//   namespace nonstd { namespace scope { struct deleter_latency_hooks; } }
+//   #define scope_CONFIG_HOOKS  ::nonstd::scope::deleter_latency_hooks
+//
+// and include this header where unique_resource is used. With another policy, install
+// compose_hooks< other, deleter_latency_hooks >, so that the other's hooks are not timed.
+
+struct deleter_latency_hooks
+{
+    template< class T > static void on_construct( T const & ) noexcept {}
+    template< class T > static void on_release( T const & ) noexcept {}
+
+    template< class T > static int before_exit( T const & ) noexcept { return 0; }
+    template< class T > static void after_exit( T const &, int ) noexcept {}
+
+    // The token is the start time, or 0 if the call is not sampled:
+
+    template< class T >
+    static std::uint64_t before_delete( T const & ) noexcept
+    {
+        static thread_local unsigned skipped = 0;
+
+        if ( ++skipped < deleter_latency::sampling() )
+            return 0;
+
+        skipped = 0;
+        return latency_clock::now();
+    }
+
+    template< class T >
+    static void after_delete( T const &, std::uint64_t start ) noexcept
+    {
+        if ( start == 0 )
+            return;
+
+        std::uint64_t const end = latency_clock::now();
+
+        try
+        {
+            deleter_latency::record<T>( end > start ? end - start : 0 );
+        }
+        catch ( ... ) {}
+    }
+};
+
+}} // namespace nonstd::scope
+
+namespace nonstd
+{
+    using scope::deleter_latency;
+    using scope::deleter_latency_hooks;
+}
+
+#endif // scope_HAVE_DELETER_LATENCY
+
+#endif // NONSTD_SCOPE_DELETER_LATENCY_HPP
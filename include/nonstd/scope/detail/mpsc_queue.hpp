@@ -0,0 +1,123 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Implementation detail: a lock-free multi-producer single-consumer queue of actions,
+// shared by the extensions that hand work to another thread. Requires C++11.
+
+#ifndef NONSTD_SCOPE_DETAIL_MPSC_QUEUE_HPP
+#define NONSTD_SCOPE_DETAIL_MPSC_QUEUE_HPP
+
+#include <atomic>
+#include <utility>
+
+namespace nonstd {
+namespace scope {
+namespace detail {
+
+// A queued action; execute() runs it once, the consumer deletes it afterwards:
+
+struct mpsc_node
+{
+    mpsc_node()
+        : next( nullptr )
+    {}
+
+    virtual ~mpsc_node() {}
+
+    virtual void execute() noexcept {}
+
+    std::atomic<mpsc_node *> next;
+};
+
+template< class Fn >
+struct mpsc_action : mpsc_node
+{
+    template< class F >
+    explicit mpsc_action( F && f )
+        : fn( std::forward<F>( f ) )
+    {}
+
+    void execute() noexcept
+    {
+        fn();
+    }
+
+    Fn fn;
+};
+
+// Vyukov's intrusive MPSC queue, with a stub node:
+//
+// - push() may be called from any thread; its exchange is sequentially consistent, so
+//   that a producer's later loads, e.g. of a 'closed' flag, are ordered after it,
+// - pop() is for the single consumer; it returns null if the queue is empty, or if a
+//   producer is between its exchange and its link.
+
+class mpsc_queue
+{
+public:
+    mpsc_queue()
+        : head( &stub )
+        , tail( &stub )
+    {}
+
+    void push( mpsc_node * n ) noexcept
+    {
+        n->next.store( nullptr, std::memory_order_relaxed );
+        mpsc_node * prev = head.exchange( n, std::memory_order_seq_cst );
+        prev->next.store( n, std::memory_order_release );
+    }
+
+    mpsc_node * pop() noexcept
+    {
+        mpsc_node * t    = tail;
+        mpsc_node * next = t->next.load( std::memory_order_acquire );
+
+        if ( t == &stub )
+        {
+            if ( next == nullptr )
+                return nullptr;
+
+            tail = next;
+            t    = next;
+            next = next->next.load( std::memory_order_acquire );
+        }
+
+        if ( next )
+        {
+            tail = next;
+            return t;
+        }
+
+        if ( t != head.load( std::memory_order_acquire ) )
+            return nullptr;
+
+        push( &stub );
+
+        next = t->next.load( std::memory_order_acquire );
+
+        if ( next )
+        {
+            tail = next;
+            return t;
+        }
+
+        return nullptr;
+    }
+
+    mpsc_queue( mpsc_queue const & ) = delete;
+    mpsc_queue & operator=( mpsc_queue const & ) = delete;
+
+private:
+    mpsc_node stub;
+    std::atomic<mpsc_node *> head;
+    mpsc_node * tail;
+};
+
+}}} // namespace nonstd::scope::detail
+
+#endif // NONSTD_SCOPE_DETAIL_MPSC_QUEUE_HPP
@@ -0,0 +1,142 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Implementation detail: a registry of statistics per type, of which each thread writes
+// its own shard, shared by the hook policies that observe all unique_resources. Requires C++11.
+
+#ifndef NONSTD_SCOPE_DETAIL_THREAD_SHARDS_HPP
+#define NONSTD_SCOPE_DETAIL_THREAD_SHARDS_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace nonstd {
+namespace scope {
+namespace detail {
+
+// Increment a counter of a shard; a single writer needs no read-modify-write:
+
+inline void single_writer_increment( std::atomic<std::uint64_t> & n ) noexcept
+{
+    n.store( n.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+}
+
+// shard_registry<Type>: the statistics of all types, one Type each, by index. A Type has:
+// - shard: the part of the statistics that one thread writes,
+// - shard * add_shard(): the shard of a thread that starts to write,
+// - void retire( shard const * ) noexcept: fold the shard of a thread that exits into the totals.
+// The registry is never destroyed, so that threads may exit after static destruction began.
+
+template< class Type >
+class shard_registry
+{
+public:
+    static shard_registry & instance()
+    {
+        static shard_registry * const registry = new shard_registry();
+        return *registry;
+    }
+
+    template< class... Args >
+    std::size_t add_type( Args &&... args )
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        types.push_back( std::unique_ptr<Type>( new Type( std::forward<Args>( args )... ) ) );
+        return types.size() - 1;
+    }
+
+    Type & type( std::size_t index ) const
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        return *types[ index ];
+    }
+
+    // Call f( type ) for each type, outside the lock, as types are not removed:
+
+    template< class F >
+    void for_each( F f ) const
+    {
+        std::vector<Type *> all;
+
+        // scope:
+        {
+            std::lock_guard<std::mutex> lock( mutex );
+
+            for ( auto const & t : types )
+                all.push_back( t.get() );
+        }
+
+        for ( Type * t : all )
+            f( *t );
+    }
+
+private:
+    mutable std::mutex mutex;
+    std::vector< std::unique_ptr<Type> > types;
+};
+
+// thread_shards<Type>: the shards of this thread, by type index. Once they are destroyed,
+// e.g. for a unique_resource in a static or in a later thread_local, get() returns nullptr.
+
+template< class Type >
+class thread_shards
+{
+public:
+    typedef typename Type::shard shard;
+
+    static shard * get( std::size_t type )
+    {
+        if ( gone() )
+            return nullptr;
+
+        static thread_local thread_shards this_thread;
+        return this_thread.get_or_add( type );
+    }
+
+    ~thread_shards()
+    {
+        gone() = true;
+
+        shard_registry<Type> & registry = shard_registry<Type>::instance();
+
+        for ( std::size_t type = 0; type < shards.size(); ++type )
+        {
+            if ( shards[ type ] )
+                registry.type( type ).retire( shards[ type ] );
+        }
+    }
+
+private:
+    static bool & gone() noexcept
+    {
+        static thread_local bool destroyed = false;
+        return destroyed;
+    }
+
+    shard * get_or_add( std::size_t type )
+    {
+        if ( type >= shards.size() )
+            shards.resize( type + 1, nullptr );
+
+        if ( !shards[ type ] )
+            shards[ type ] = shard_registry<Type>::instance().type( type ).add_shard();
+
+        return shards[ type ];
+    }
+
+    std::vector<shard *> shards;
+};
+
+}}} // namespace nonstd::scope::detail
+
+#endif // NONSTD_SCOPE_DETAIL_THREAD_SHARDS_HPP
@@ -0,0 +1,481 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Non-standard extension: epoch-based reclamation of unique_resources,
+// with scope_epoch to pin the current epoch for the enclosing scope.
+
+#ifndef NONSTD_SCOPE_EBR_DOMAIN_HPP
+#define NONSTD_SCOPE_EBR_DOMAIN_HPP
+
+#include "../scope.hpp"
+
+#define scope_HAVE_EBR_DOMAIN  ( scope_CPP11_OR_GREATER && !scope_CONFIG_NO_EXTENSIONS )
+
+#if scope_HAVE_EBR_DOMAIN
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <thread>
+#include <utility>
+
+namespace nonstd {
+namespace scope {
+
+class scope_epoch;
+
+// ebr_domain:
+//
+// - a reader pins the global epoch via scope_epoch while it accesses shared data,
+// - retire() takes ownership of an unlinked resource and defers its deleter,
+// - a resource retired in epoch e is deleted once the global epoch reached e + 2,
+//   which can only happen after all readers pinned in epoch e have left their scope.
+//
+// Each participating thread claims a slot for the duration of a pin or retire;
+// retired resources are batched per slot and reclaimed batch-wise. The domain starts with
+// thread_slots slots; while all are claimed, claim() appends a segment of as many, which
+// lives as long as the domain. Only if that allocation fails does it wait for a free slot.
+// The domain must outlive its scope_epoch guards; it deletes all pending resources on destruction.
+
+class ebr_domain
+{
+public:
+    explicit ebr_domain( std::size_t thread_slots = 64, std::size_t max_batch = 64 )
+        : global_epoch( 0 )
+        , batch_size( max_batch )
+        , first( thread_slots > 0 ? thread_slots : 1 )
+    {}
+
+    ~ebr_domain()
+    {
+        for_each_slot( []( slot & s )
+        {
+            for ( auto & bucket : s.buckets )
+                bucket.clear();
+        } );
+    }
+
+    template< class R, class D >
+    void retire( unique_resource<R, D> && r );
+
+    // Try to advance the epoch and delete what can be deleted in all unclaimed slots:
+
+    void reclaim() noexcept
+    {
+        try_advance();
+
+        for_each_slot( [this]( slot & s )
+        {
+            if ( s.try_claim() )
+            {
+                s.collect( global_epoch.load( std::memory_order_acquire ) );
+                s.unclaim();
+            }
+        } );
+    }
+
+    std::uint64_t epoch() const noexcept
+    {
+        return global_epoch.load( std::memory_order_acquire );
+    }
+
+    ebr_domain( ebr_domain const & ) = delete;
+    ebr_domain & operator=( ebr_domain const & ) = delete;
+
+private:
+    friend class scope_epoch;
+
+    // type-erased retired resource:
+
+    struct retired_node
+    {
+        retired_node()
+            : next( nullptr )
+        {}
+
+        virtual ~retired_node() {}
+
+        retired_node * next;
+    };
+
+    template< class R, class D >
+    struct retired_resource : retired_node
+    {
+        explicit retired_resource( unique_resource<R, D> && r )
+            : resource( std::move( r ) )
+        {}
+
+        unique_resource<R, D> resource;
+    };
+
+    // resources retired in one epoch:
+
+    struct bucket
+    {
+        bucket()
+            : epoch( 0 )
+            , head( nullptr )
+            , size( 0 )
+        {}
+
+        void push( retired_node * n ) noexcept
+        {
+            n->next = head;
+            head = n;
+            ++size;
+        }
+
+        void clear() noexcept
+        {
+            while ( head )
+            {
+                retired_node * next = head->next;
+                delete head;
+                head = next;
+            }
+            size = 0;
+        }
+
+        std::uint64_t epoch;
+        retired_node * head;
+        std::size_t size;
+    };
+
+    // Per-thread slot; the pinned state is (epoch << 1) | 1, or 0 when not pinned.
+    // Epochs are 64-bit, so they do not wrap around in practice:
+
+    struct slot
+    {
+        slot()
+            : claimed( false )
+            , state( 0 )
+        {}
+
+        bool try_claim() noexcept
+        {
+            return !claimed.load( std::memory_order_relaxed )
+                && !claimed.exchange( true, std::memory_order_acquire );
+        }
+
+        void unclaim() noexcept
+        {
+            claimed.store( false, std::memory_order_release );
+        }
+
+        std::size_t pending() const noexcept
+        {
+            return buckets[0].size + buckets[1].size + buckets[2].size;
+        }
+
+        // Delete the buckets retired at least two epochs before global:
+
+        void collect( std::uint64_t global ) noexcept
+        {
+            for ( auto & b : buckets )
+            {
+                if ( b.head && global - b.epoch >= 2 )
+                    b.clear();
+            }
+        }
+
+        std::atomic<bool> claimed;
+        std::atomic<std::uint64_t> state;
+        bucket buckets[3];
+        char padding[64];       // keep slots on separate cache lines
+    };
+
+    // Slots come in segments; a segment is appended to the last one and never removed:
+
+    struct segment
+    {
+        explicit segment( std::size_t n )
+            : size( n )
+            , slots( new slot[ n ] )
+            , next( nullptr )
+        {}
+
+        segment( std::size_t n, slot * s ) noexcept
+            : size( n )
+            , slots( s )
+            , next( nullptr )
+        {}
+
+        ~segment()
+        {
+            delete next.load( std::memory_order_relaxed );
+        }
+
+        std::size_t const size;
+        std::unique_ptr<slot[]> slots;
+        std::atomic<segment *> next;
+    };
+
+    template< class F >
+    void for_each_slot( F f ) noexcept
+    {
+        for ( segment * g = &first; g; g = g->next.load( std::memory_order_acquire ) )
+        {
+            for ( std::size_t i = 0; i < g->size; ++i )
+                f( g->slots[i] );
+        }
+    }
+
+    // Claim a free slot; append a segment if all are claimed, or yield until
+    // one is released if memory for a segment is exhausted:
+
+    slot & claim() noexcept
+    {
+        thread_local std::size_t hint = std::hash<std::thread::id>()( std::this_thread::get_id() );
+
+        for (;;)
+        {
+            segment * last = &first;
+
+            for ( segment * g = &first; g; g = g->next.load( std::memory_order_acquire ) )
+            {
+                for ( std::size_t i = 0; i < g->size; ++i )
+                {
+                    std::size_t const k = ( hint + i ) % g->size;
+
+                    if ( g->slots[k].try_claim() )
+                    {
+                        hint = k;
+                        return g->slots[k];
+                    }
+                }
+                last = g;
+            }
+
+            if ( slot * s = grow( *last ) )
+                return *s;
+
+            std::this_thread::yield();
+        }
+    }
+
+    // Append a segment whose first slot is claimed by the caller; nullptr if out of memory:
+
+    slot * grow( segment & last ) noexcept
+    {
+        std::unique_ptr<slot[]> slots( new( std::nothrow ) slot[ first.size ] );
+
+        if ( !slots )
+            return nullptr;
+
+        segment * const g = new( std::nothrow ) segment( first.size, slots.get() );
+
+        if ( !g )
+            return nullptr;
+
+        slots.release();
+        g->slots[0].try_claim();
+
+        segment * tail = &last;
+        segment * expected = nullptr;
+
+        while ( !tail->next.compare_exchange_weak( expected, g, std::memory_order_release, std::memory_order_acquire ) )
+        {
+            if ( expected )
+            {
+                tail = expected;
+                expected = nullptr;
+            }
+        }
+
+        return &g->slots[0];
+    }
+
+    void pin( slot & s ) noexcept
+    {
+        std::uint64_t e = global_epoch.load( std::memory_order_relaxed );
+
+        for (;;)
+        {
+            s.state.store( ( e << 1 ) | 1u, std::memory_order_seq_cst );
+
+            std::uint64_t const now = global_epoch.load( std::memory_order_seq_cst );
+
+            if ( now == e )
+                return;
+
+            e = now;
+        }
+    }
+
+    void unpin( slot & s ) noexcept
+    {
+        s.state.store( 0, std::memory_order_release );
+    }
+
+    // Advance the global epoch if all pinned slots observed the current one:
+
+    bool try_advance() noexcept
+    {
+        std::uint64_t e = global_epoch.load( std::memory_order_seq_cst );
+        bool behind = false;
+
+        for_each_slot( [&]( slot & s )
+        {
+            std::uint64_t const state = s.state.load( std::memory_order_seq_cst );
+
+            behind = behind || ( ( state & 1u ) && state != ( ( e << 1 ) | 1u ) );
+        } );
+
+        if ( behind )
+            return false;
+
+        return global_epoch.compare_exchange_strong( e, e + 1, std::memory_order_seq_cst );
+    }
+
+    void retire_in( slot & s, retired_node * n ) noexcept
+    {
+        std::uint64_t const e = global_epoch.load( std::memory_order_seq_cst );
+
+        // The bucket for this epoch holds either this epoch's resources,
+        // or resources retired three or more epochs ago:
+
+        bucket & b = s.buckets[ static_cast<std::size_t>( e % 3 ) ];
+
+        if ( b.epoch != e )
+        {
+            b.clear();
+            b.epoch = e;
+        }
+
+        b.push( n );
+
+        if ( s.pending() >= batch_size )
+        {
+            try_advance();
+            s.collect( global_epoch.load( std::memory_order_acquire ) );
+        }
+    }
+
+private:
+    std::atomic<std::uint64_t> global_epoch;
+    std::size_t const batch_size;
+    segment first;
+};
+
+// default domain:
+
+inline ebr_domain & default_ebr_domain()
+{
+    static ebr_domain domain;
+    return domain;
+}
+
+// scope_epoch: pin the domain's current epoch for the enclosing scope.
+// A nested scope_epoch for the same domain on the same thread reuses the outer pin.
+
+class scope_epoch
+{
+public:
+    scope_epoch() noexcept
+        : scope_epoch( default_ebr_domain() )
+    {}
+
+    explicit scope_epoch( ebr_domain & d ) noexcept
+        : domain( d )
+        , pinned( find( d ) )
+        , outer( top() )
+    {
+        if ( pinned == nullptr )
+        {
+            pinned = &domain.claim();
+            domain.pin( *pinned );
+            owner = true;
+        }
+        top() = this;
+    }
+
+    ~scope_epoch()
+    {
+        top() = outer;
+
+        if ( owner )
+        {
+            domain.unpin( *pinned );
+            pinned->unclaim();
+        }
+    }
+
+    scope_epoch( scope_epoch const & ) = delete;
+    scope_epoch & operator=( scope_epoch const & ) = delete;
+
+private:
+    friend class ebr_domain;
+
+    static scope_epoch * & top() noexcept
+    {
+        thread_local scope_epoch * innermost = nullptr;
+        return innermost;
+    }
+
+    // slot pinned by this thread for the given domain, if any:
+
+    static ebr_domain::slot * find( ebr_domain const & d ) noexcept
+    {
+        for ( scope_epoch * g = top(); g; g = g->outer )
+        {
+            if ( &g->domain == &d )
+                return g->pinned;
+        }
+        return nullptr;
+    }
+
+private:
+    ebr_domain & domain;
+    ebr_domain::slot * pinned;
+    scope_epoch * outer;
+    bool owner = false;
+};
+
+// Retire r: its deleter runs once all readers pinned at this point have left their scope.
+
+template< class R, class D >
+void ebr_domain::retire( unique_resource<R, D> && r )
+{
+    retired_node * n = new retired_resource<R, D>( std::move( r ) );
+
+    if ( slot * s = scope_epoch::find( *this ) )
+    {
+        retire_in( *s, n );
+    }
+    else
+    {
+        slot & own = claim();
+        retire_in( own, n );
+        own.unclaim();
+    }
+}
+
+// retire in the default domain:
+
+template< class R, class D >
+void retire( unique_resource<R, D> && r )
+{
+    default_ebr_domain().retire( std::move( r ) );
+}
+
+}} // namespace nonstd::scope
+
+namespace nonstd
+{
+    using scope::ebr_domain;
+    using scope::scope_epoch;
+    using scope::default_ebr_domain;
+    using scope::retire;
+}
+
+#endif // scope_HAVE_EBR_DOMAIN
+
+#endif // NONSTD_SCOPE_EBR_DOMAIN_HPP
@@ -0,0 +1,136 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Non-standard extension: fast_shutdown() and reclaimable_deleter, skip the
+// deleters of resources the operating system reclaims at process exit anyway.
+
+#ifndef NONSTD_SCOPE_FAST_SHUTDOWN_HPP
+#define NONSTD_SCOPE_FAST_SHUTDOWN_HPP
+
+#include "../scope.hpp"
+
+#define scope_HAVE_FAST_SHUTDOWN  ( scope_CPP11_OR_GREATER && !scope_CONFIG_NO_EXTENSIONS )
+
+#if scope_HAVE_FAST_SHUTDOWN
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace nonstd {
+namespace scope {
+
+namespace detail {
+
+inline std::atomic<bool> & fast_shutdown_state() noexcept
+{
+    static std::atomic<bool> instance( false );
+    return instance;
+}
+
+inline std::atomic<std::uint64_t> & fast_shutdown_skips() noexcept
+{
+    static std::atomic<std::uint64_t> instance( 0 );
+    return instance;
+}
+
+} // namespace detail
+
+// Enter fast-shutdown mode: from now on, reclaimable deleters do nothing.
+// Call it once the process is committed to exit, e.g. before returning from main().
+
+inline void fast_shutdown() noexcept
+{
+    detail::fast_shutdown_state().store( true, std::memory_order_release );
+}
+
+inline bool is_fast_shutdown() noexcept
+{
+    return detail::fast_shutdown_state().load( std::memory_order_acquire );
+}
+
+// Number of reclaimable deleters skipped since fast_shutdown():
+
+inline std::uint64_t fast_shutdown_skipped() noexcept
+{
+    return detail::fast_shutdown_skips().load( std::memory_order_relaxed );
+}
+
+// reclaimable_deleter: classifies a resource as reclaimable, such as memory,
+// mappings and descriptors, that the operating system releases at process exit.
+// It calls D, unless fast_shutdown() was entered. Deleters that are not wrapped
+// are essential, such as flush and fsync, and always run.
+// It also wraps exit functions of scope_exit and friends.
+
+template< class D >
+class reclaimable_deleter
+{
+public:
+    reclaimable_deleter()
+        : deleter()
+    {}
+
+    explicit reclaimable_deleter( D const & d )
+        : deleter( d )
+    {}
+
+    explicit reclaimable_deleter( D && d )
+        : deleter( std::move( d ) )
+    {}
+
+    template< class... Args >
+    void operator()( Args const &... args ) const
+    {
+        if ( is_fast_shutdown() )
+        {
+            detail::fast_shutdown_skips().fetch_add( 1, std::memory_order_relaxed );
+            return;
+        }
+
+        deleter( args... );
+    }
+
+    D const & get_deleter() const noexcept
+    {
+        return deleter;
+    }
+
+private:
+    D deleter;
+};
+
+template< class D >
+reclaimable_deleter<typename std::decay<D>::type>
+make_reclaimable_deleter( D && d )
+{
+    return reclaimable_deleter<typename std::decay<D>::type>( std::forward<D>( d ) );
+}
+
+template< class R, class D, class S = typename std::decay<R>::type >
+unique_resource<typename std::decay<R>::type, reclaimable_deleter<typename std::decay<D>::type>>
+make_reclaimable_resource_checked( R && r, S const & invalid, D && d )
+{
+    return make_unique_resource_checked( std::forward<R>( r ), invalid, make_reclaimable_deleter( std::forward<D>( d ) ) );
+}
+
+}} // namespace nonstd::scope
+
+namespace nonstd
+{
+    using scope::fast_shutdown;
+    using scope::is_fast_shutdown;
+    using scope::fast_shutdown_skipped;
+    using scope::reclaimable_deleter;
+    using scope::make_reclaimable_deleter;
+    using scope::make_reclaimable_resource_checked;
+}
+
+#endif // scope_HAVE_FAST_SHUTDOWN
+
+#endif // NONSTD_SCOPE_FAST_SHUTDOWN_HPP
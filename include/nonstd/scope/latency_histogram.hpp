@@ -0,0 +1,269 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Non-standard extension: latency_clock, a cheap clock, latency_histogram, a log-linear
+// histogram of its ticks, and latency_sink, a histogram that threads add to lock-free.
+
+#ifndef NONSTD_SCOPE_LATENCY_HISTOGRAM_HPP
+#define NONSTD_SCOPE_LATENCY_HISTOGRAM_HPP
+
+#include "../scope.hpp"
+
+#define scope_HAVE_LATENCY_HISTOGRAM  ( scope_CPP11_OR_GREATER && !scope_CONFIG_NO_EXTENSIONS )
+
+#if scope_HAVE_LATENCY_HISTOGRAM
+
+#if defined( __x86_64__ ) || defined( __i386__ ) || defined( _M_X64 ) || defined( _M_IX86 )
+# define scope_HAVE_RDTSC  1
+#else
+# define scope_HAVE_RDTSC  0
+#endif
+
+#if scope_HAVE_RDTSC
+# if defined( _MSC_VER )
+#  include <intrin.h>
+# else
+#  include <x86intrin.h>
+# endif
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace nonstd {
+namespace scope {
+
+// latency_clock: the time stamp counter where available, else steady_clock in nanoseconds.
+// Ticks are converted to nanoseconds with a rate measured once, on the first conversion.
+
+struct latency_clock
+{
+    static std::uint64_t now() noexcept
+    {
+#if scope_HAVE_RDTSC
+        return __rdtsc();
+#else
+        return static_cast<std::uint64_t>( std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch() ).count() );
+#endif
+    }
+
+    static double ticks_per_nanosecond() noexcept
+    {
+#if scope_HAVE_RDTSC
+        static double const rate = calibrate();
+        return rate;
+#else
+        return 1.0;
+#endif
+    }
+
+    static std::uint64_t to_nanoseconds( std::uint64_t ticks ) noexcept
+    {
+        return static_cast<std::uint64_t>( static_cast<double>( ticks ) / ticks_per_nanosecond() );
+    }
+
+    static std::uint64_t from_nanoseconds( std::uint64_t ns ) noexcept
+    {
+        return static_cast<std::uint64_t>( static_cast<double>( ns ) * ticks_per_nanosecond() );
+    }
+
+private:
+    // Count ticks during 2 ms of steady_clock:
+
+    static double calibrate() noexcept
+    {
+        typedef std::chrono::steady_clock clock;
+
+        clock::time_point const t0 = clock::now();
+        std::uint64_t const c0 = now();
+        clock::time_point t1 = t0;
+
+        while ( t1 - t0 < std::chrono::milliseconds( 2 ) )
+            t1 = clock::now();
+
+        std::uint64_t const c1 = now();
+        double const ns = static_cast<double>( std::chrono::duration_cast<std::chrono::nanoseconds>( t1 - t0 ).count() );
+
+        return c1 > c0 ? static_cast<double>( c1 - c0 ) / ns : 1.0;
+    }
+};
+
+// latency_histogram: counts of latencies in ticks, in log-linear buckets: values below 4
+// have a bucket each, and each power of two above is split into 4 buckets, for a
+// resolution of 25%. A histogram is a snapshot; merge() adds another one.
+
+class latency_histogram
+{
+public:
+    enum
+    {
+        sub_bucket_bits = 2,
+        sub_buckets     = 1 << sub_bucket_bits,
+        bucket_count    = ( 64 - sub_bucket_bits + 1 ) * sub_buckets
+    };
+
+    latency_histogram() noexcept
+        : counts()
+    {}
+
+    static std::size_t bucket_of( std::uint64_t ticks ) noexcept
+    {
+        if ( ticks < sub_buckets )
+            return static_cast<std::size_t>( ticks );
+
+        unsigned const msb = log2( ticks );
+
+        return ( msb - sub_bucket_bits + 1 ) * sub_buckets
+            + static_cast<std::size_t>( ( ticks >> ( msb - sub_bucket_bits ) ) & ( sub_buckets - 1 ) );
+    }
+
+    // The smallest number of ticks in bucket i:
+
+    static std::uint64_t lower_bound( std::size_t i ) noexcept
+    {
+        if ( i < sub_buckets )
+            return i;
+
+        std::size_t const group = i / sub_buckets;
+        std::uint64_t const sub = i % sub_buckets;
+
+        return ( sub_buckets + sub ) << ( group - 1 );
+    }
+
+    // The largest number of ticks in bucket i:
+
+    static std::uint64_t upper_bound( std::size_t i ) noexcept
+    {
+        return i + 1 < bucket_count ? lower_bound( i + 1 ) - 1 : ~std::uint64_t( 0 );
+    }
+
+    void add( std::uint64_t ticks, std::uint64_t n = 1 ) noexcept
+    {
+        counts[ bucket_of( ticks ) ] += n;
+    }
+
+    void merge( latency_histogram const & other ) noexcept
+    {
+        for ( std::size_t i = 0; i < bucket_count; ++i )
+            counts[ i ] += other.counts[ i ];
+    }
+
+    std::uint64_t bucket( std::size_t i ) const noexcept
+    {
+        return counts[ i ];
+    }
+
+    std::uint64_t count() const noexcept
+    {
+        std::uint64_t n = 0;
+
+        for ( std::size_t i = 0; i < bucket_count; ++i )
+            n += counts[ i ];
+
+        return n;
+    }
+
+    // The upper bound in ticks of the bucket that holds quantile q, 0 <= q <= 1;
+    // 0 if the histogram is empty:
+
+    std::uint64_t quantile( double q ) const noexcept
+    {
+        std::uint64_t const n = count();
+
+        if ( n == 0 )
+            return 0;
+
+        std::uint64_t rank = q >= 1 ? n : static_cast<std::uint64_t>( q * static_cast<double>( n ) + 0.5 );
+        std::uint64_t seen = 0;
+
+        if ( rank == 0 )
+            rank = 1;
+
+        for ( std::size_t i = 0; i < bucket_count; ++i )
+        {
+            seen += counts[ i ];
+
+            if ( seen >= rank )
+                return upper_bound( i );
+        }
+        return upper_bound( bucket_count - 1 );
+    }
+
+private:
+    // v > 0:
+
+    static unsigned log2( std::uint64_t v ) noexcept
+    {
+#if defined( __GNUC__ ) || defined( __clang__ )
+        return 63u - static_cast<unsigned>( __builtin_clzll( v ) );
+#else
+        unsigned r = 0;
+
+        while ( v >>= 1 )
+            ++r;
+
+        return r;
+#endif
+    }
+
+    std::uint64_t counts[ bucket_count ];
+};
+
+// latency_sink: a histogram that any thread adds to with one relaxed increment,
+// e.g. shared by all timers of one code path; snapshot() reads it.
+
+class latency_sink
+{
+public:
+    latency_sink() noexcept
+    {
+        for ( auto & c : counts )
+            c.store( 0, std::memory_order_relaxed );
+    }
+
+    void add( std::uint64_t ticks ) noexcept
+    {
+        counts[ latency_histogram::bucket_of( ticks ) ].fetch_add( 1, std::memory_order_relaxed );
+    }
+
+    latency_histogram snapshot() const noexcept
+    {
+        latency_histogram h;
+
+        for ( std::size_t i = 0; i < latency_histogram::bucket_count; ++i )
+        {
+            std::uint64_t const n = counts[ i ].load( std::memory_order_relaxed );
+
+            if ( n )
+                h.add( latency_histogram::lower_bound( i ), n );
+        }
+        return h;
+    }
+
+    latency_sink( latency_sink const & ) = delete;
+    latency_sink & operator=( latency_sink const & ) = delete;
+
+private:
+    std::atomic<std::uint64_t> counts[ latency_histogram::bucket_count ];
+};
+
+}} // namespace nonstd::scope
+
+namespace nonstd
+{
+    using scope::latency_clock;
+    using scope::latency_histogram;
+    using scope::latency_sink;
+}
+
+#endif // scope_HAVE_LATENCY_HISTOGRAM
+
+#endif // NONSTD_SCOPE_LATENCY_HISTOGRAM_HPP
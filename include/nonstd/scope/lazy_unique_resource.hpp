@@ -0,0 +1,141 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Non-standard extension: lazy_unique_resource, acquire a resource on first use,
+// thread-safe, and release it only if it was acquired.
+
+#ifndef NONSTD_SCOPE_LAZY_UNIQUE_RESOURCE_HPP
+#define NONSTD_SCOPE_LAZY_UNIQUE_RESOURCE_HPP
+
+#include "../scope.hpp"
+
+#define scope_HAVE_LAZY_UNIQUE_RESOURCE  ( scope_CPP11_OR_GREATER && !scope_CONFIG_NO_EXTENSIONS )
+
+#if scope_HAVE_LAZY_UNIQUE_RESOURCE
+
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace nonstd {
+namespace scope {
+
+// lazy_unique_resource: holds factory F, invalid value S and deleter D; the first get()
+// acquires the resource via F.
+//
+// - once acquired, get() is a single acquire-load; the first callers serialize on a mutex,
+//   with call_once semantics: one caller acquires, the others wait for it,
+// - like make_unique_resource_checked(), a resource equal to the invalid value is not deleted,
+// - if F throws, the exception propagates and a later get() tries again,
+// - the destructor calls D only if a valid resource was acquired.
+
+template< class R, class D, class F, class S = R >
+class lazy_unique_resource
+{
+public:
+    template< class FF, class SS, class DD >
+    lazy_unique_resource( FF && f, SS && invalid, DD && d )
+        : factory( std::forward<FF>( f ) )
+        , invalid_value( std::forward<SS>( invalid ) )
+        , deleter( std::forward<DD>( d ) )
+        , storage()     // zeroed, so that GCC does not see the resource as maybe uninitialized
+        , state( empty )
+    {}
+
+    ~lazy_unique_resource()
+    {
+        if ( state.load( std::memory_order_acquire ) == empty )
+            return;
+
+        if ( !( resource() == invalid_value ) )
+            deleter( resource() );
+
+        resource().~R();
+    }
+
+    R const & get()
+    {
+        if ( state.load( std::memory_order_acquire ) == empty )
+            acquire_once();
+
+        return resource();
+    }
+
+    // True if a resource was acquired and it is not the invalid value:
+
+    bool is_acquired() const noexcept
+    {
+        return state.load( std::memory_order_acquire ) == acquired;
+    }
+
+    // True if the factory ran, whether or not its resource is valid:
+
+    bool is_initialized() const noexcept
+    {
+        return state.load( std::memory_order_acquire ) != empty;
+    }
+
+    D const & get_deleter() const noexcept
+    {
+        return deleter;
+    }
+
+    lazy_unique_resource( lazy_unique_resource const & ) = delete;
+    lazy_unique_resource & operator=( lazy_unique_resource const & ) = delete;
+
+private:
+    enum acquisition { empty, invalid, acquired };
+
+    // Unlike std::call_once, which some implementations do not leave
+    // reusable when the function throws:
+
+    void acquire_once()
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+
+        if ( state.load( std::memory_order_relaxed ) != empty )
+            return;
+
+        ::new( static_cast<void *>( storage ) ) R( factory() );
+
+        state.store( resource() == invalid_value ? invalid : acquired, std::memory_order_release );
+    }
+
+    R & resource() noexcept
+    {
+        return *reinterpret_cast<R *>( storage );
+    }
+
+    F factory;
+    S invalid_value;
+    D deleter;
+    alignas( R ) unsigned char storage[ sizeof( R ) ];
+    std::atomic<acquisition> state;
+    std::mutex mutex;
+};
+
+#if scope_CPP17_OR_GREATER
+
+template< class FF, class SS, class DD >
+lazy_unique_resource( FF &&, SS &&, DD && ) -> lazy_unique_resource<
+    std::decay_t<std::invoke_result_t<std::decay_t<FF> &>>, std::decay_t<DD>, std::decay_t<FF>, std::decay_t<SS> >;
+
+#endif // scope_CPP17_OR_GREATER
+
+}} // namespace nonstd::scope
+
+namespace nonstd
+{
+    using scope::lazy_unique_resource;
+}
+
+#endif // scope_HAVE_LAZY_UNIQUE_RESOURCE
+
+#endif // NONSTD_SCOPE_LAZY_UNIQUE_RESOURCE_HPP
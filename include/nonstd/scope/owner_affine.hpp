@@ -0,0 +1,278 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Non-standard extension: owner_affine_deleter, release thread-affine resources
+// on the thread that acquired them, via that thread's lock-free inbox.
+
+#ifndef NONSTD_SCOPE_OWNER_AFFINE_HPP
+#define NONSTD_SCOPE_OWNER_AFFINE_HPP
+
+#include "../scope.hpp"
+
+#define scope_HAVE_OWNER_AFFINE  ( scope_CPP11_OR_GREATER && !scope_CONFIG_NO_EXTENSIONS )
+
+#if scope_HAVE_OWNER_AFFINE
+
+#include "detail/mpsc_queue.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace nonstd {
+namespace scope {
+
+namespace detail {
+
+// A thread's inbox: other threads push releases, the owner thread pops and runs them.
+// When the owner exits, it closes the inbox; releases that arrive later run on the
+// releasing thread, as there is no owner left to run them.
+
+class owner_inbox
+{
+public:
+    owner_inbox()
+        : queue()
+        , pushed( 0 )
+        , consumed( 0 )
+        , closed( false )
+        , consuming( false )
+    {}
+
+    ~owner_inbox()
+    {
+        drain();
+    }
+
+    // The calling thread's inbox, created on first use:
+
+    static std::shared_ptr<owner_inbox> const & current()
+    {
+        thread_local holder h;
+
+        if ( !h.inbox )
+        {
+            h.inbox = std::make_shared<owner_inbox>();
+            current_ptr() = h.inbox.get();
+        }
+
+        return h.inbox;
+    }
+
+    static bool is_current( owner_inbox const * inbox ) noexcept
+    {
+        return current_ptr() == inbox;
+    }
+
+    // false if the owner has exited: the caller then runs the release itself.
+
+    template< class Fn >
+    bool push( Fn && fn ) noexcept
+    {
+        typedef mpsc_action<typename std::decay<Fn>::type> action_type;
+
+        if ( closed.load( std::memory_order_seq_cst ) )
+            return false;
+
+        action_type * a = new( std::nothrow ) action_type( std::forward<Fn>( fn ) );
+
+        if ( a == nullptr )
+            return false;
+
+        pushed.fetch_add( 1, std::memory_order_seq_cst );
+        queue.push( a );
+
+        // The owner may have closed the inbox after its last drain; then drain here:
+
+        if ( closed.load( std::memory_order_seq_cst ) )
+            drain_closed();
+
+        return true;
+    }
+
+    // Run the releases pushed so far; returns their number:
+
+    std::size_t drain() noexcept
+    {
+        if ( consuming.exchange( true, std::memory_order_acquire ) )
+            return 0;
+
+        std::size_t count = 0;
+
+        while ( mpsc_node * n = queue.pop() )
+        {
+            n->execute();
+            delete n;
+            ++count;
+        }
+
+        consumed += count;
+        consuming.store( false, std::memory_order_release );
+        return count;
+    }
+
+    std::size_t pending() const noexcept
+    {
+        return pushed.load( std::memory_order_relaxed ) - consumed.load( std::memory_order_relaxed );
+    }
+
+    void close() noexcept
+    {
+        closed.store( true, std::memory_order_seq_cst );
+        drain_closed();
+    }
+
+    owner_inbox( owner_inbox const & ) = delete;
+    owner_inbox & operator=( owner_inbox const & ) = delete;
+
+private:
+    // Closes the inbox when its thread exits. From then on, releases to the thread's
+    // own resources are no longer recognized as same-thread, and run via push() failing.
+
+    struct holder
+    {
+        ~holder()
+        {
+            current_ptr() = nullptr;
+
+            if ( inbox )
+                inbox->close();
+        }
+
+        std::shared_ptr<owner_inbox> inbox;
+    };
+
+    // Plain pointer for the same-thread test, as it has no destructor to order:
+
+    static owner_inbox const * & current_ptr() noexcept
+    {
+        thread_local owner_inbox const * p = nullptr;
+        return p;
+    }
+
+    // After close, pushers and the exiting owner contend to drain until all
+    // completed pushes have run:
+
+    void drain_closed() noexcept
+    {
+        while ( consumed.load( std::memory_order_seq_cst ) < pushed.load( std::memory_order_seq_cst ) )
+        {
+            if ( drain() == 0 )
+                std::this_thread::yield();
+        }
+    }
+
+private:
+    mpsc_queue queue;
+
+    std::atomic<std::size_t> pushed;
+    std::atomic<std::size_t> consumed;
+    std::atomic<bool> closed;
+    std::atomic<bool> consuming;
+};
+
+} // namespace detail
+
+// Run the releases that other threads pushed to the calling thread's inbox;
+// returns their number:
+
+inline std::size_t drain_owner_inbox()
+{
+    return detail::owner_inbox::current()->drain();
+}
+
+// owner_affine_deleter: records the thread that constructs it. Destruction on that
+// thread calls deleter D directly; destruction on another thread pushes the release
+// to the owner's inbox, to run at the owner's next acquire or drain_owner_inbox().
+// After the owner exited, or if the release cannot be queued, D runs on the releasing thread.
+
+template< class D >
+class owner_affine_deleter
+{
+public:
+    owner_affine_deleter()
+        : deleter()
+        , owner( detail::owner_inbox::current() )
+    {}
+
+    explicit owner_affine_deleter( D const & d )
+        : deleter( d )
+        , owner( detail::owner_inbox::current() )
+    {}
+
+    explicit owner_affine_deleter( D && d )
+        : deleter( std::move( d ) )
+        , owner( detail::owner_inbox::current() )
+    {}
+
+    template< class R >
+    void operator()( R const & resource ) const noexcept
+    {
+        if ( detail::owner_inbox::is_current( owner.get() ) )
+        {
+            deleter( resource );
+            return;
+        }
+
+        D const d = deleter;
+        R const r = resource;
+
+        if ( !owner->push( [d, r]{ d( r ); } ) )
+            deleter( resource );
+    }
+
+    bool is_owner_thread() const noexcept
+    {
+        return detail::owner_inbox::is_current( owner.get() );
+    }
+
+    D const & get_deleter() const noexcept
+    {
+        return deleter;
+    }
+
+private:
+    D deleter;
+    std::shared_ptr<detail::owner_inbox> owner;
+};
+
+template< class D >
+owner_affine_deleter<typename std::decay<D>::type>
+make_owner_affine_deleter( D && d )
+{
+    return owner_affine_deleter<typename std::decay<D>::type>( std::forward<D>( d ) );
+}
+
+// Acquire with an owner-affine deleter; first runs the releases pending for this thread:
+
+template< class R, class D, class S = typename std::decay<R>::type >
+unique_resource<typename std::decay<R>::type, owner_affine_deleter<typename std::decay<D>::type>>
+make_owner_affine_resource_checked( R && r, S const & invalid, D && d )
+{
+    drain_owner_inbox();
+
+    return make_unique_resource_checked( std::forward<R>( r ), invalid, make_owner_affine_deleter( std::forward<D>( d ) ) );
+}
+
+}} // namespace nonstd::scope
+
+namespace nonstd
+{
+    using scope::owner_affine_deleter;
+    using scope::make_owner_affine_deleter;
+    using scope::make_owner_affine_resource_checked;
+    using scope::drain_owner_inbox;
+}
+
+#endif // scope_HAVE_OWNER_AFFINE
+
+#endif // NONSTD_SCOPE_OWNER_AFFINE_HPP
@@ -0,0 +1,270 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Non-standard extension: reclaimer and offload_deleter, run slow deleters
+// on a background thread instead of on the thread that drops the resource.
+
+#ifndef NONSTD_SCOPE_RECLAIMER_HPP
+#define NONSTD_SCOPE_RECLAIMER_HPP
+
+#include "../scope.hpp"
+
+#define scope_HAVE_RECLAIMER  ( scope_CPP11_OR_GREATER && !scope_CONFIG_NO_EXTENSIONS )
+
+#if scope_HAVE_RECLAIMER
+
+#include "detail/mpsc_queue.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace nonstd {
+namespace scope {
+
+// reclaimer:
+//
+// - submit() queues an action on a lock-free multi-producer single-consumer queue,
+// - a background thread runs the queued actions in order of submission,
+// - when max_depth actions are pending, or memory is exhausted, submit() runs the action itself,
+// - flush() waits until the actions submitted before the call have run,
+// - the destructor runs all pending actions before it joins the background thread.
+//
+// Actions run on the background thread, so they must not depend on the submitting thread,
+// and they must not call flush() on their own reclaimer.
+
+class reclaimer
+{
+public:
+    explicit reclaimer( std::size_t max_depth = 4096 )
+        : queue()
+        , capacity( max_depth )
+        , depth( 0 )
+        , submitted( 0 )
+        , completed( 0 )
+        , synchronous( 0 )
+        , sleeping( false )
+        , flushers( 0 )
+        , stopping( false )
+        , worker( [this]{ run(); } )
+    {}
+
+    ~reclaimer()
+    {
+        stopping.store( true, std::memory_order_seq_cst );
+        {
+            std::lock_guard<std::mutex> lock( mutex );
+            work_cv.notify_one();
+        }
+        worker.join();
+    }
+
+    template< class Fn >
+    void submit( Fn && fn ) noexcept
+    {
+        typedef detail::mpsc_action<typename std::decay<Fn>::type> action_type;
+
+        if ( depth.fetch_add( 1, std::memory_order_seq_cst ) >= capacity )
+        {
+            depth.fetch_sub( 1, std::memory_order_relaxed );
+            run_here( fn );
+            return;
+        }
+
+        action_type * a = new( std::nothrow ) action_type( std::forward<Fn>( fn ) );
+
+        if ( a == nullptr )
+        {
+            depth.fetch_sub( 1, std::memory_order_relaxed );
+            run_here( fn );
+            return;
+        }
+
+        submitted.fetch_add( 1, std::memory_order_seq_cst );
+        queue.push( a );
+
+        if ( sleeping.load( std::memory_order_seq_cst ) )
+        {
+            std::lock_guard<std::mutex> lock( mutex );
+            work_cv.notify_one();
+        }
+    }
+
+    void flush()
+    {
+        std::uint64_t const target = submitted.load( std::memory_order_seq_cst );
+
+        std::unique_lock<std::mutex> lock( mutex );
+        flushers.fetch_add( 1, std::memory_order_seq_cst );
+
+        flush_cv.wait( lock, [&]{ return completed.load( std::memory_order_seq_cst ) >= target; } );
+
+        flushers.fetch_sub( 1, std::memory_order_relaxed );
+    }
+
+    // number of queued actions that did not run yet:
+
+    std::size_t pending() const noexcept
+    {
+        return depth.load( std::memory_order_relaxed );
+    }
+
+    // number of actions that ran synchronously because the queue was full:
+
+    std::uint64_t synchronous_count() const noexcept
+    {
+        return synchronous.load( std::memory_order_relaxed );
+    }
+
+    reclaimer( reclaimer const & ) = delete;
+    reclaimer & operator=( reclaimer const & ) = delete;
+
+private:
+    template< class Fn >
+    void run_here( Fn & fn ) noexcept
+    {
+        synchronous.fetch_add( 1, std::memory_order_relaxed );
+        fn();
+    }
+
+    void run() noexcept
+    {
+        for (;;)
+        {
+            if ( detail::mpsc_node * n = queue.pop() )
+            {
+                n->execute();
+                delete n;
+
+                depth.fetch_sub( 1, std::memory_order_seq_cst );
+                completed.fetch_add( 1, std::memory_order_seq_cst );
+
+                if ( flushers.load( std::memory_order_seq_cst ) > 0 )
+                {
+                    std::lock_guard<std::mutex> lock( mutex );
+                    flush_cv.notify_all();
+                }
+                continue;
+            }
+
+            if ( depth.load( std::memory_order_seq_cst ) > 0 )
+            {
+                std::this_thread::yield();      // a producer is linking its node
+                continue;
+            }
+
+            if ( stopping.load( std::memory_order_seq_cst ) )
+                return;
+
+            std::unique_lock<std::mutex> lock( mutex );
+            sleeping.store( true, std::memory_order_seq_cst );
+
+            work_cv.wait( lock, [this]{
+                return depth.load( std::memory_order_seq_cst ) > 0 || stopping.load( std::memory_order_seq_cst ); } );
+
+            sleeping.store( false, std::memory_order_relaxed );
+        }
+    }
+
+private:
+    detail::mpsc_queue queue;
+
+    std::size_t const capacity;
+    std::atomic<std::size_t> depth;
+    std::atomic<std::uint64_t> submitted;
+    std::atomic<std::uint64_t> completed;
+    std::atomic<std::uint64_t> synchronous;
+
+    std::atomic<bool> sleeping;
+    std::atomic<int> flushers;
+    std::atomic<bool> stopping;
+
+    std::mutex mutex;
+    std::condition_variable work_cv;
+    std::condition_variable flush_cv;
+
+    std::thread worker;     // last: starts after all other members are initialized
+};
+
+inline reclaimer & default_reclaimer()
+{
+    static reclaimer instance;
+    return instance;
+}
+
+// offload_deleter: hand the resource to a reclaimer, which runs deleter D on its thread.
+
+template< class D >
+class offload_deleter
+{
+public:
+    offload_deleter()
+        : deleter()
+        , target( &default_reclaimer() )
+    {}
+
+    explicit offload_deleter( D const & d, reclaimer & r = default_reclaimer() )
+        : deleter( d )
+        , target( &r )
+    {}
+
+    explicit offload_deleter( D && d, reclaimer & r = default_reclaimer() )
+        : deleter( std::move( d ) )
+        , target( &r )
+    {}
+
+    template< class R >
+    void operator()( R const & resource ) const noexcept
+    {
+        D const d = deleter;
+        R const r = resource;
+
+        target->submit( [d, r]{ d( r ); } );
+    }
+
+    D const & get_deleter() const noexcept
+    {
+        return deleter;
+    }
+
+    reclaimer & get_reclaimer() const noexcept
+    {
+        return *target;
+    }
+
+private:
+    D deleter;
+    reclaimer * target;
+};
+
+template< class D >
+offload_deleter<typename std::decay<D>::type>
+make_offload_deleter( D && d, reclaimer & r = default_reclaimer() )
+{
+    return offload_deleter<typename std::decay<D>::type>( std::forward<D>( d ), r );
+}
+
+}} // namespace nonstd::scope
+
+namespace nonstd
+{
+    using scope::reclaimer;
+    using scope::default_reclaimer;
+    using scope::offload_deleter;
+    using scope::make_offload_deleter;
+}
+
+#endif // scope_HAVE_RECLAIMER
+
+#endif // NONSTD_SCOPE_RECLAIMER_HPP
@@ -0,0 +1,373 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Non-standard extension: resource_governor, bound the number of live
+// unique_resources per category, with backpressure at acquisition.
+
+#ifndef NONSTD_SCOPE_RESOURCE_GOVERNOR_HPP
+#define NONSTD_SCOPE_RESOURCE_GOVERNOR_HPP
+
+#include "../scope.hpp"
+
+#define scope_HAVE_RESOURCE_GOVERNOR  ( scope_CPP11_OR_GREATER && !scope_CONFIG_NO_EXTENSIONS )
+
+#if scope_HAVE_RESOURCE_GOVERNOR
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace nonstd {
+namespace scope {
+
+class resource_budget;
+
+// budget_permit: the right to create one resource, refunded unless it is
+// handed over to a governed unique_resource.
+
+class budget_permit
+{
+public:
+    budget_permit() noexcept
+        : budget( nullptr )
+    {}
+
+    budget_permit( budget_permit && other ) noexcept
+        : budget( other.budget )
+    {
+        other.budget = nullptr;
+    }
+
+    budget_permit & operator=( budget_permit && other ) noexcept;
+
+    ~budget_permit();
+
+    // true if the permit was granted:
+
+    explicit operator bool() const noexcept
+    {
+        return budget != nullptr;
+    }
+
+    // Give up the permit without refunding it, for the caller to refund later:
+
+    resource_budget * release() noexcept
+    {
+        resource_budget * b = budget;
+        budget = nullptr;
+        return b;
+    }
+
+    budget_permit( budget_permit const & ) = delete;
+    budget_permit & operator=( budget_permit const & ) = delete;
+
+private:
+    friend class resource_budget;
+
+    explicit budget_permit( resource_budget * b ) noexcept
+        : budget( b )
+    {}
+
+private:
+    resource_budget * budget;
+};
+
+// resource_budget: lock-free counting budget of one category of resources.
+// Only waiting for a permit uses a mutex and condition variable.
+
+class resource_budget
+{
+public:
+    explicit resource_budget( std::size_t limit ) noexcept
+        : live_count( 0 )
+        , peak_count( 0 )
+        , waiters( 0 )
+        , max_count( limit )
+    {}
+
+    budget_permit try_acquire() noexcept
+    {
+        return budget_permit( try_charge() ? this : nullptr );
+    }
+
+    budget_permit acquire()
+    {
+        if ( try_charge() )
+            return budget_permit( this );
+
+        std::unique_lock<std::mutex> lock( mutex );
+        waiter_count count( waiters );
+
+        cv.wait( lock, [this]{ return try_charge(); } );
+
+        return budget_permit( this );
+    }
+
+    template< class Clock, class Duration >
+    budget_permit acquire_until( std::chrono::time_point<Clock, Duration> const & deadline )
+    {
+        if ( try_charge() )
+            return budget_permit( this );
+
+        std::unique_lock<std::mutex> lock( mutex );
+        waiter_count count( waiters );
+
+        return budget_permit( cv.wait_until( lock, deadline, [this]{ return try_charge(); } ) ? this : nullptr );
+    }
+
+    template< class Rep, class Period >
+    budget_permit acquire_for( std::chrono::duration<Rep, Period> const & timeout )
+    {
+        return acquire_until( std::chrono::steady_clock::now() + timeout );
+    }
+
+    // Return one unit to the budget and wake a waiter, if any:
+
+    void refund() noexcept
+    {
+        live_count.fetch_sub( 1, std::memory_order_seq_cst );
+
+        if ( waiters.load( std::memory_order_seq_cst ) > 0 )
+        {
+            std::lock_guard<std::mutex> lock( mutex );
+            cv.notify_one();
+        }
+    }
+
+    std::size_t live() const noexcept
+    {
+        return live_count.load( std::memory_order_relaxed );
+    }
+
+    std::size_t peak() const noexcept
+    {
+        return peak_count.load( std::memory_order_relaxed );
+    }
+
+    std::size_t limit() const noexcept
+    {
+        return max_count;
+    }
+
+    resource_budget( resource_budget const & ) = delete;
+    resource_budget & operator=( resource_budget const & ) = delete;
+
+private:
+    struct waiter_count
+    {
+        explicit waiter_count( std::atomic<std::size_t> & n ) noexcept
+            : count( n )
+        {
+            count.fetch_add( 1, std::memory_order_seq_cst );
+        }
+
+        ~waiter_count()
+        {
+            count.fetch_sub( 1, std::memory_order_seq_cst );
+        }
+
+        std::atomic<std::size_t> & count;
+    };
+
+    // The initial load is sequentially consistent to pair with refund(),
+    // so a waiter cannot miss the wake-up of a concurrent refund:
+
+    bool try_charge() noexcept
+    {
+        std::size_t n = live_count.load( std::memory_order_seq_cst );
+
+        do
+        {
+            if ( n >= max_count )
+                return false;
+        }
+        while ( !live_count.compare_exchange_weak( n, n + 1, std::memory_order_acquire, std::memory_order_relaxed ) );
+
+        std::size_t p = peak_count.load( std::memory_order_relaxed );
+
+        while ( n + 1 > p && !peak_count.compare_exchange_weak( p, n + 1, std::memory_order_relaxed ) )
+        {}
+
+        return true;
+    }
+
+private:
+    std::atomic<std::size_t> live_count;
+    std::atomic<std::size_t> peak_count;
+    std::atomic<std::size_t> waiters;
+    std::size_t const max_count;
+    std::mutex mutex;
+    std::condition_variable cv;
+};
+
+inline budget_permit & budget_permit::operator=( budget_permit && other ) noexcept
+{
+    if ( &other != this )
+    {
+        if ( budget )
+            budget->refund();
+
+        budget = other.release();
+    }
+    return *this;
+}
+
+inline budget_permit::~budget_permit()
+{
+    if ( budget )
+        budget->refund();
+}
+
+// governed_deleter: runs the deleter, then refunds the budget.
+
+template< class D >
+class governed_deleter
+{
+public:
+    governed_deleter()
+        : deleter()
+        , budget( nullptr )
+    {}
+
+    governed_deleter( D const & d, resource_budget * b )
+        : deleter( d )
+        , budget( b )
+    {}
+
+    governed_deleter( D && d, resource_budget * b )
+        : deleter( std::move( d ) )
+        , budget( b )
+    {}
+
+    template< class R >
+    void operator()( R const & resource ) const
+    {
+        deleter( resource );
+
+        if ( budget )
+            budget->refund();
+    }
+
+    D const & get_deleter() const noexcept
+    {
+        return deleter;
+    }
+
+    resource_budget * get_budget() const noexcept
+    {
+        return budget;
+    }
+
+private:
+    D deleter;
+    resource_budget * budget;
+};
+
+// Create a governed unique_resource, see make_unique_resource_checked().
+// A valid resource takes over the permit, an invalid one refunds it immediately.
+
+template< class R, class D, class S = typename std::decay<R>::type >
+unique_resource< typename std::decay<R>::type, governed_deleter<typename std::decay<D>::type> >
+make_governed_resource_checked( budget_permit && permit, R && resource, S const & invalid, D && deleter )
+{
+    bool const valid = !bool( resource == invalid );
+
+    budget_permit granted( std::move( permit ) );
+
+    governed_deleter<typename std::decay<D>::type> gd(
+        std::forward<D>( deleter ), valid ? granted.release() : nullptr );
+
+    return unique_resource< typename std::decay<R>::type, governed_deleter<typename std::decay<D>::type> >(
+        std::forward<R>( resource ), std::move( gd ), valid );
+}
+
+// resource_governor: named budgets; registration locks, acquisition does not.
+
+class resource_governor
+{
+public:
+    resource_governor() {}
+
+    // Get the category's budget, creating it with the given limit if needed:
+
+    resource_budget & category( std::string const & name, std::size_t limit )
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+
+        for ( auto & c : categories )
+        {
+            if ( c.name == name )
+                return c.budget;
+        }
+
+        categories.emplace_back( name, limit );
+        return categories.back().budget;
+    }
+
+    resource_budget * find( std::string const & name )
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+
+        for ( auto & c : categories )
+        {
+            if ( c.name == name )
+                return &c.budget;
+        }
+        return nullptr;
+    }
+
+    // Visit all categories as fn( name, budget ):
+
+    template< class Fn >
+    void for_each( Fn fn )
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+
+        for ( auto & c : categories )
+            fn( c.name, c.budget );
+    }
+
+    resource_governor( resource_governor const & ) = delete;
+    resource_governor & operator=( resource_governor const & ) = delete;
+
+private:
+    struct entry
+    {
+        entry( std::string const & n, std::size_t limit )
+            : name( n )
+            , budget( limit )
+        {}
+
+        std::string name;
+        resource_budget budget;
+    };
+
+    std::mutex mutex;
+    std::list<entry> categories;
+};
+
+}} // namespace nonstd::scope
+
+namespace nonstd
+{
+    using scope::budget_permit;
+    using scope::resource_budget;
+    using scope::governed_deleter;
+    using scope::resource_governor;
+    using scope::make_governed_resource_checked;
+}
+
+#endif // scope_HAVE_RESOURCE_GOVERNOR
+
+#endif // NONSTD_SCOPE_RESOURCE_GOVERNOR_HPP
@@ -0,0 +1,555 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Non-standard extension: resource_tracking_hooks, a hook policy that counts the live
+// unique_resources per type, optionally samples where they were acquired, and reports
+// them with dump_live_resources().
+
+#ifndef NONSTD_SCOPE_RESOURCE_TRACKING_HPP
+#define NONSTD_SCOPE_RESOURCE_TRACKING_HPP
+
+#include "type_name.hpp"
+
+#define scope_HAVE_RESOURCE_TRACKING  ( scope_HAVE_TYPE_NAME && scope_HAVE_HOOKS )
+
+#if scope_HAVE_RESOURCE_TRACKING
+
+#include "detail/thread_shards.hpp"
+
+#if defined( __has_include )
+# if __has_include( <execinfo.h> )
+#  define scope_HAVE_EXECINFO_H  1
+# endif
+#endif
+
+#ifndef scope_HAVE_EXECINFO_H
+# define scope_HAVE_EXECINFO_H  0
+#endif
+
+// Record the acquisition site of 1 in N unique_resources per thread and type, 0 for none;
+// see resource_tracking::set_site_sampling():
+
+#ifndef  scope_CONFIG_RESOURCE_TRACKING_SITE_SAMPLING
+# define scope_CONFIG_RESOURCE_TRACKING_SITE_SAMPLING  0
+#endif
+
+#if scope_HAVE_EXECINFO_H
+# include <execinfo.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace nonstd {
+namespace scope {
+
+// The counts of one resource type, e.g. unique_resource<int, close_fd>:
+// - live: resources that are owned now,
+// - peak: the most live resources seen; it is sampled, so a short burst may be missed,
+// - acquired: resources that were owned since the start, released ones included.
+
+struct resource_gauge
+{
+    std::string name;
+    std::int64_t live;
+    std::int64_t peak;
+    std::uint64_t acquired;
+};
+
+namespace detail {
+
+// Where a resource was acquired, and when; the frames include those of this library,
+// which the report skips:
+
+struct resource_site
+{
+    static std::size_t const max_frames = 16;
+
+    std::chrono::steady_clock::time_point acquired;
+    void * frames[ max_frames ];
+    int frame_count;
+};
+
+// The counts of one resource type and one thread, written by that thread and read by
+// snapshots. The padding keeps the counts of different threads on separate cache lines:
+
+struct resource_shard
+{
+    resource_shard() noexcept
+        : acquired( 0 )
+        , released( 0 )
+        , unsampled( 0 )
+    {}
+
+    char padding_before[64];
+    std::atomic<std::uint64_t> acquired;
+    std::atomic<std::uint64_t> released;
+    unsigned unsampled;             // acquisitions since the last sampled site, owner only
+    char padding_after[64];
+};
+
+// One resource type: the shards of live threads, the totals of threads that exited,
+// the peak and the sampled sites of live resources, by handle:
+
+class resource_type
+{
+public:
+    typedef resource_shard shard;
+
+    resource_type( std::string name_, bool pointer_handles_ )
+        : name( std::move( name_ ) )
+        , pointer_handles( pointer_handles_ )
+        , retired_acquired( 0 )
+        , retired_released( 0 )
+        , peak( 0 )
+        , site_count( 0 )
+    {}
+
+    resource_shard * add_shard()
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        shards.push_back( std::unique_ptr<resource_shard>( new resource_shard() ) );
+        return shards.back().get();
+    }
+
+    void retire( resource_shard const * shard ) noexcept
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+
+        for ( std::size_t i = 0; i < shards.size(); ++i )
+        {
+            if ( shards[ i ].get() == shard )
+            {
+                retired_acquired += shard->acquired.load( std::memory_order_relaxed );
+                retired_released += shard->released.load( std::memory_order_relaxed );
+                shards.erase( shards.begin() + static_cast<std::ptrdiff_t>( i ) );
+                break;
+            }
+        }
+    }
+
+    // Count directly into the totals, for a thread whose shards are gone:
+
+    void add_retired( std::uint64_t acquired, std::uint64_t released ) noexcept
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        retired_acquired += acquired;
+        retired_released += released;
+    }
+
+    // Refresh the peak if no one else holds the lock, from the hot path:
+
+    void try_refresh_peak() noexcept
+    {
+        std::unique_lock<std::mutex> lock( mutex, std::try_to_lock );
+
+        if ( lock.owns_lock() )
+        {
+            std::uint64_t acquired = 0;
+            refresh_locked( acquired );
+        }
+    }
+
+    resource_gauge gauge() const
+    {
+        resource_gauge g;
+        g.name = name;
+
+        std::lock_guard<std::mutex> lock( mutex );
+        g.live = refresh_locked( g.acquired );
+        g.peak = peak;
+        return g;
+    }
+
+    // Sites, by handle; site_count lets the release of an unsampled resource skip the lock:
+
+    void add_site( std::uintptr_t handle, resource_site const & site )
+    {
+        std::lock_guard<std::mutex> lock( site_mutex );
+        sites[ handle ] = site;
+        site_count.store( sites.size(), std::memory_order_relaxed );
+    }
+
+    void erase_site( std::uintptr_t handle ) noexcept
+    {
+        if ( site_count.load( std::memory_order_relaxed ) == 0 )
+            return;
+
+        std::lock_guard<std::mutex> lock( site_mutex );
+        sites.erase( handle );
+        site_count.store( sites.size(), std::memory_order_relaxed );
+    }
+
+    // The sites of live resources, oldest first:
+
+    std::vector< std::pair<std::uintptr_t, resource_site> > oldest_sites( std::size_t max_sites ) const
+    {
+        std::vector< std::pair<std::uintptr_t, resource_site> > result;
+
+        // scope:
+        {
+            std::lock_guard<std::mutex> lock( site_mutex );
+            result.assign( sites.begin(), sites.end() );
+        }
+
+        typedef std::pair<std::uintptr_t, resource_site> entry;
+
+        std::sort( result.begin(), result.end(), []( entry const & a, entry const & b )
+        {
+            return a.second.acquired < b.second.acquired;
+        } );
+
+        if ( result.size() > max_sites )
+            result.resize( max_sites );
+
+        return result;
+    }
+
+    std::string const name;
+    bool const pointer_handles;
+
+private:
+    // The live count, and the acquired count in acquired. Releases may be counted on
+    // another thread than their acquisition, and shards are read one after another, so
+    // a concurrent read may briefly see too few live:
+
+    std::int64_t refresh_locked( std::uint64_t & acquired_ ) const noexcept
+    {
+        std::uint64_t acquired = retired_acquired;
+        std::uint64_t released = retired_released;
+
+        for ( auto const & shard : shards )
+        {
+            acquired += shard->acquired.load( std::memory_order_relaxed );
+            released += shard->released.load( std::memory_order_relaxed );
+        }
+
+        std::int64_t const live = acquired > released ? static_cast<std::int64_t>( acquired - released ) : 0;
+
+        peak = (std::max)( peak, live );
+        acquired_ = acquired;
+        return live;
+    }
+
+    mutable std::mutex mutex;
+    std::vector< std::unique_ptr<resource_shard> > shards;
+    std::uint64_t retired_acquired;
+    std::uint64_t retired_released;
+    mutable std::int64_t peak;
+
+    mutable std::mutex site_mutex;
+    std::unordered_map<std::uintptr_t, resource_site> sites;
+    std::atomic<std::size_t> site_count;
+};
+
+typedef shard_registry<resource_type> resource_registry;
+
+// Sites are keyed by handle, for handles that are integers, enums or pointers:
+
+template< class R >
+struct is_trackable_handle : std::integral_constant< bool,
+    std::is_integral<R>::value || std::is_enum<R>::value || std::is_pointer<R>::value > {};
+
+template< class R >
+std::uintptr_t handle_key( R const & r, std::true_type /*pointer*/ ) noexcept
+{
+    return reinterpret_cast<std::uintptr_t>( r );
+}
+
+template< class R >
+std::uintptr_t handle_key( R const & r, std::false_type /*pointer*/ ) noexcept
+{
+    return static_cast<std::uintptr_t>( r );
+}
+
+template< class T >
+struct resource_handle_of;
+
+template< class R, class D >
+struct resource_handle_of< unique_resource<R, D> >
+{
+    typedef R type;
+};
+
+template< class T >
+std::size_t resource_type_index()
+{
+    typedef typename resource_handle_of<T>::type handle;
+
+    static std::size_t const index = resource_registry::instance().add_type(
+        type_name<T>(), std::is_pointer<handle>::value );
+    return index;
+}
+
+template< class T >
+resource_type & resource_type_of()
+{
+    static resource_type & type = resource_registry::instance().type( resource_type_index<T>() );
+    return type;
+}
+
+inline std::atomic<unsigned> & resource_site_sampling() noexcept
+{
+    static std::atomic<unsigned> sampling( scope_CONFIG_RESOURCE_TRACKING_SITE_SAMPLING );
+    return sampling;
+}
+
+// Peak is refreshed on read, and on the first peak_period acquisitions per thread and
+// type, then on every peak_period-th one:
+
+std::uint64_t const resource_peak_period = 64;
+
+inline void capture_site( resource_site & site ) noexcept
+{
+    site.acquired = std::chrono::steady_clock::now();
+#if scope_HAVE_EXECINFO_H
+    site.frame_count = ::backtrace( site.frames, static_cast<int>( resource_site::max_frames ) );
+#else
+    site.frame_count = 0;
+#endif
+}
+
+template< class R, class D >
+void sample_site( resource_type & type, resource_shard & shard, unique_resource<R, D> const & r, std::true_type /*trackable*/ )
+{
+    unsigned const sampling = resource_site_sampling().load( std::memory_order_relaxed );
+
+    if ( sampling == 0 || ++shard.unsampled < sampling )
+        return;
+
+    shard.unsampled = 0;
+
+    resource_site site;
+    capture_site( site );
+    type.add_site( handle_key( r.get(), std::is_pointer<R>() ), site );
+}
+
+template< class R, class D >
+void sample_site( resource_type &, resource_shard &, unique_resource<R, D> const &, std::false_type /*trackable*/ ) noexcept {}
+
+template< class R, class D >
+void erase_site( resource_type & type, unique_resource<R, D> const & r, std::true_type /*trackable*/ ) noexcept
+{
+    type.erase_site( handle_key( r.get(), std::is_pointer<R>() ) );
+}
+
+template< class R, class D >
+void erase_site( resource_type &, unique_resource<R, D> const &, std::false_type /*trackable*/ ) noexcept {}
+
+} // namespace detail
+
+// resource_tracking: the counts and sites that resource_tracking_hooks recorded.
+
+class resource_tracking
+{
+public:
+    // Record the site of 1 in n acquisitions per thread and type, 0 for none:
+
+    static void set_site_sampling( unsigned n ) noexcept
+    {
+        detail::resource_site_sampling().store( n, std::memory_order_relaxed );
+    }
+
+    static unsigned site_sampling() noexcept
+    {
+        return detail::resource_site_sampling().load( std::memory_order_relaxed );
+    }
+
+    // Record that a unique_resource took or gave up ownership of its resource:
+
+    template< class R, class D >
+    static void acquired( unique_resource<R, D> const & r )
+    {
+        typedef unique_resource<R, D> T;
+
+        detail::resource_type & type = detail::resource_type_of<T>();
+        detail::resource_shard * shard = detail::thread_shards<detail::resource_type>::get( detail::resource_type_index<T>() );
+
+        if ( !shard )
+        {
+            type.add_retired( 1, 0 );
+            return;
+        }
+
+        detail::single_writer_increment( shard->acquired );
+
+        std::uint64_t const n = shard->acquired.load( std::memory_order_relaxed );
+
+        if ( n <= detail::resource_peak_period || n % detail::resource_peak_period == 0 )
+            type.try_refresh_peak();
+
+        detail::sample_site( type, *shard, r, detail::is_trackable_handle<R>() );
+    }
+
+    template< class R, class D >
+    static void released( unique_resource<R, D> const & r )
+    {
+        typedef unique_resource<R, D> T;
+
+        detail::resource_type & type = detail::resource_type_of<T>();
+        detail::resource_shard * shard = detail::thread_shards<detail::resource_type>::get( detail::resource_type_index<T>() );
+
+        detail::erase_site( type, r, detail::is_trackable_handle<R>() );
+
+        if ( shard )
+            detail::single_writer_increment( shard->released );
+        else
+            type.add_retired( 0, 1 );
+    }
+
+    // The counts of type T, e.g. unique_resource<int, close_fd>, over all threads:
+
+    template< class T >
+    static resource_gauge snapshot()
+    {
+        return detail::resource_type_of<T>().gauge();
+    }
+
+    // Call f( gauge ) for each type that was tracked:
+
+    template< class F >
+    static void for_each( F f )
+    {
+        detail::resource_registry::instance().for_each( [&f]( detail::resource_type const & type )
+        {
+            f( type.gauge() );
+        } );
+    }
+};
+
+// Write a line with the counts per type, followed by the oldest max_sites sampled sites
+// of its live resources, with their age and their symbolized call stacks; link with
+// -rdynamic for function names:
+
+inline void dump_live_resources( std::ostream & os, std::size_t max_sites = 8 )
+{
+    os << "live resources, 1 in " << resource_tracking::site_sampling() << " sites sampled:\n";
+
+    std::chrono::steady_clock::time_point const now = std::chrono::steady_clock::now();
+
+    detail::resource_registry::instance().for_each( [&]( detail::resource_type const & type )
+    {
+        resource_gauge const g = type.gauge();
+
+        if ( g.acquired == 0 )
+            return;
+
+        os << type.name << ": live=" << g.live << " peak=" << g.peak << " acquired=" << g.acquired << "\n";
+
+        for ( auto const & entry : type.oldest_sites( max_sites ) )
+        {
+            std::uintptr_t const handle = entry.first;
+            detail::resource_site const & site = entry.second;
+
+            os << "  handle ";
+
+            if ( type.pointer_handles )
+                os << reinterpret_cast<void const *>( handle );
+            else
+                os << static_cast<std::intptr_t>( handle );
+
+            os << ", acquired " << std::chrono::duration_cast<std::chrono::milliseconds>( now - site.acquired ).count()
+                << "ms ago:\n";
+
+#if scope_HAVE_EXECINFO_H
+            std::unique_ptr<char *, void(*)(void*)> symbols( ::backtrace_symbols( site.frames, site.frame_count ), std::free );
+
+            int first = 0;
+
+            while ( symbols && first < site.frame_count && std::strstr( symbols.get()[ first ], "_ZN6nonstd5scope" ) )
+                ++first;
+
+            for ( int i = first; i < site.frame_count; ++i )
+                os << "    " << ( symbols ? symbols.get()[ i ] : "?" ) << "\n";
+#endif
+        }
+    } );
+}
+
+// resource_tracking_hooks: a hook policy, see scope_CONFIG_HOOKS, that counts each
+// unique_resource that takes ownership of a resource as acquired, and each that calls
+// its deleter or is released as released. Guards are not tracked. To use it:
+//
+//   // nonstd/scope.tweak.hpp:
+//   namespace nonstd { namespace scope { struct resource_tracking_hooks; } }
+//   #define scope_CONFIG_HOOKS  ::nonstd::scope::resource_tracking_hooks
+//
+// and include this header where unique_resource is used.
+
+struct resource_tracking_hooks
+{
+    template< class T > static void on_construct( T const & ) noexcept {}
+    template< class T > static void on_release( T const & ) noexcept {}
+
+    template< class T > static int before_exit( T const & ) noexcept { return 0; }
+    template< class T > static void after_exit( T const &, int ) noexcept {}
+
+    template< class T > static int before_delete( T const & ) noexcept { return 0; }
+    template< class T > static void after_delete( T const &, int ) noexcept {}
+
+    template< class R, class D >
+    static void on_construct( unique_resource<R, D> const & r ) noexcept
+    {
+        try
+        {
+            resource_tracking::acquired( r );
+        }
+        catch ( ... ) {}
+    }
+
+    template< class R, class D >
+    static void on_release( unique_resource<R, D> const & r ) noexcept
+    {
+        try
+        {
+            resource_tracking::released( r );
+        }
+        catch ( ... ) {}
+    }
+
+    // Count the release before the deleter runs, so that its site is gone before
+    // the handle can be reused, e.g. by another open():
+
+    template< class R, class D >
+    static int before_delete( unique_resource<R, D> const & r ) noexcept
+    {
+        try
+        {
+            resource_tracking::released( r );
+        }
+        catch ( ... ) {}
+
+        return 0;
+    }
+};
+
+}} // namespace nonstd::scope
+
+namespace nonstd
+{
+    using scope::resource_gauge;
+    using scope::resource_tracking;
+    using scope::resource_tracking_hooks;
+    using scope::dump_live_resources;
+}
+
+#endif // scope_HAVE_RESOURCE_TRACKING
+
+#endif // NONSTD_SCOPE_RESOURCE_TRACKING_HPP
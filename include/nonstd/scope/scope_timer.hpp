@@ -0,0 +1,252 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Non-standard extension: scope_timer, a guard that records the time its scope took
+// into a latency_sink, and calls an out-of-line callback if it exceeded a budget.
+
+#ifndef NONSTD_SCOPE_SCOPE_TIMER_HPP
+#define NONSTD_SCOPE_SCOPE_TIMER_HPP
+
+#include "latency_histogram.hpp"
+
+#define scope_HAVE_SCOPE_TIMER  scope_HAVE_LATENCY_HISTOGRAM
+
+#if scope_HAVE_SCOPE_TIMER
+
+#if defined( __GNUC__ ) || defined( __clang__ )
+# define scope_COLD_NOINLINE  __attribute__(( cold, noinline ))
+#elif defined( _MSC_VER )
+# define scope_COLD_NOINLINE  __declspec( noinline )
+#else
+# define scope_COLD_NOINLINE
+#endif
+
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace nonstd {
+namespace scope {
+
+// The callback of a timer without a budget, which is never called:
+
+struct no_budget
+{
+    void operator()( std::chrono::nanoseconds ) const noexcept {}
+};
+
+namespace detail {
+
+// The clock's rate is measured in static initialization of a program that uses a budget,
+// rather than in its first timer with a budget, which would take 2 ms longer:
+
+template< class T = void >
+struct latency_clock_calibration
+{
+    static double const rate;
+};
+
+template< class T >
+double const latency_clock_calibration<T>::rate = latency_clock::ticks_per_nanosecond();
+
+// A budget in ticks; a negative budget is taken as zero:
+
+inline std::uint64_t budget_ticks( std::chrono::nanoseconds budget ) noexcept
+{
+    (void) latency_clock_calibration<>::rate;
+
+    return budget.count() > 0 ? latency_clock::from_nanoseconds( static_cast<std::uint64_t>( budget.count() ) ) : 0;
+}
+
+// When a timer records, like scope_exit, scope_fail and scope_success:
+
+struct on_timer_exit
+{
+    bool perform() const noexcept
+    {
+        return true;
+    }
+};
+
+struct on_timer_fail
+{
+    on_timer_fail() noexcept
+        : uncaught_on_creation( uncaught_exceptions() )
+    {}
+
+    bool perform() const noexcept
+    {
+        return uncaught_on_creation < uncaught_exceptions();
+    }
+
+    int uncaught_on_creation;
+};
+
+struct on_timer_success
+{
+    on_timer_success() noexcept
+        : uncaught_on_creation( uncaught_exceptions() )
+    {}
+
+    bool perform() const noexcept
+    {
+        return uncaught_on_creation >= uncaught_exceptions();
+    }
+
+    int uncaught_on_creation;
+};
+
+// basic_scope_timer:
+//
+// - the constructor reads latency_clock; if the outcome applies, the destructor reads it
+//   again and adds the elapsed ticks to the sink, with one relaxed increment,
+// - if the elapsed time exceeds the budget, the destructor calls on_over_budget( elapsed )
+//   via a cold function that is not inlined, to keep it out of the hot path,
+// - the budget is converted to ticks on construction, with the clock's rate that was
+//   measured during static initialization; a negative budget is taken as zero.
+
+template< class Outcome, class OnOverBudget >
+class basic_scope_timer
+{
+public:
+    explicit basic_scope_timer( latency_sink & sink_ ) noexcept
+        : sink( &sink_ )
+        , budget( (std::numeric_limits<std::uint64_t>::max)() )
+        , on_over_budget()
+        , outcome()
+        , start( latency_clock::now() )
+    {}
+
+    template< class Fn >
+    basic_scope_timer( latency_sink & sink_, std::chrono::nanoseconds budget_, Fn && fn )
+        noexcept( std::is_nothrow_constructible<OnOverBudget, Fn>::value )
+        : sink( &sink_ )
+        , budget( budget_ticks( budget_ ) )
+        , on_over_budget( std::forward<Fn>( fn ) )
+        , outcome()
+        , start( latency_clock::now() )
+    {}
+
+    basic_scope_timer( basic_scope_timer && other )
+        noexcept( std::is_nothrow_move_constructible<OnOverBudget>::value )
+        : sink( other.sink )
+        , budget( other.budget )
+        , on_over_budget( std::move( other.on_over_budget ) )
+        , outcome( other.outcome )
+        , start( other.start )
+    {
+        other.sink = nullptr;
+    }
+
+    ~basic_scope_timer()
+    {
+        if ( sink && outcome.perform() )
+        {
+            std::uint64_t const end = latency_clock::now();
+            std::uint64_t const elapsed = end > start ? end - start : 0;
+
+            sink->add( elapsed );
+
+            if ( elapsed > budget )
+                over_budget( elapsed );
+        }
+    }
+
+    // Do not record:
+
+    void release() noexcept
+    {
+        sink = nullptr;
+    }
+
+    basic_scope_timer( basic_scope_timer const & ) = delete;
+    basic_scope_timer & operator=( basic_scope_timer const & ) = delete;
+    basic_scope_timer & operator=( basic_scope_timer && ) = delete;
+
+private:
+    scope_COLD_NOINLINE void over_budget( std::uint64_t elapsed )
+    {
+        on_over_budget( std::chrono::nanoseconds( latency_clock::to_nanoseconds( elapsed ) ) );
+    }
+
+    latency_sink * sink;
+    std::uint64_t budget;
+    OnOverBudget on_over_budget;
+    Outcome outcome;
+    std::uint64_t start;
+};
+
+} // namespace detail
+
+// scope_timer records when its scope exits, scope_fail_timer only when it exits via an
+// exception, and scope_success_timer only when it exits normally:
+
+template< class OnOverBudget = no_budget >
+using scope_timer = detail::basic_scope_timer<detail::on_timer_exit, OnOverBudget>;
+
+template< class OnOverBudget = no_budget >
+using scope_fail_timer = detail::basic_scope_timer<detail::on_timer_fail, OnOverBudget>;
+
+template< class OnOverBudget = no_budget >
+using scope_success_timer = detail::basic_scope_timer<detail::on_timer_success, OnOverBudget>;
+
+inline scope_timer<> make_scope_timer( latency_sink & sink ) noexcept
+{
+    return scope_timer<>( sink );
+}
+
+template< class Fn >
+scope_timer<typename std::decay<Fn>::type>
+make_scope_timer( latency_sink & sink, std::chrono::nanoseconds budget, Fn && on_over_budget )
+{
+    return scope_timer<typename std::decay<Fn>::type>( sink, budget, std::forward<Fn>( on_over_budget ) );
+}
+
+inline scope_fail_timer<> make_scope_fail_timer( latency_sink & sink ) noexcept
+{
+    return scope_fail_timer<>( sink );
+}
+
+template< class Fn >
+scope_fail_timer<typename std::decay<Fn>::type>
+make_scope_fail_timer( latency_sink & sink, std::chrono::nanoseconds budget, Fn && on_over_budget )
+{
+    return scope_fail_timer<typename std::decay<Fn>::type>( sink, budget, std::forward<Fn>( on_over_budget ) );
+}
+
+inline scope_success_timer<> make_scope_success_timer( latency_sink & sink ) noexcept
+{
+    return scope_success_timer<>( sink );
+}
+
+template< class Fn >
+scope_success_timer<typename std::decay<Fn>::type>
+make_scope_success_timer( latency_sink & sink, std::chrono::nanoseconds budget, Fn && on_over_budget )
+{
+    return scope_success_timer<typename std::decay<Fn>::type>( sink, budget, std::forward<Fn>( on_over_budget ) );
+}
+
+}} // namespace nonstd::scope
+
+namespace nonstd
+{
+    using scope::no_budget;
+    using scope::scope_timer;
+    using scope::scope_fail_timer;
+    using scope::scope_success_timer;
+    using scope::make_scope_timer;
+    using scope::make_scope_fail_timer;
+    using scope::make_scope_success_timer;
+}
+
+#endif // scope_HAVE_SCOPE_TIMER
+
+#endif // NONSTD_SCOPE_SCOPE_TIMER_HPP
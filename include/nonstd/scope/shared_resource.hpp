@@ -0,0 +1,252 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Non-standard extension: shared_resource, a reference-counted unique_resource.
+
+#ifndef NONSTD_SCOPE_SHARED_RESOURCE_HPP
+#define NONSTD_SCOPE_SHARED_RESOURCE_HPP
+
+#include "../scope.hpp"
+
+#define scope_HAVE_SHARED_RESOURCE  ( scope_CPP11_OR_GREATER && !scope_CONFIG_NO_EXTENSIONS )
+
+#if scope_HAVE_SHARED_RESOURCE
+
+#include <atomic>
+#include <type_traits>
+#include <utility>
+
+namespace nonstd {
+namespace scope {
+
+// Reference count policies:
+//
+// - increment() adds an owner,
+// - decrement() removes an owner and yields true when it was the last one,
+// - use_count() is approximate for the atomic policy.
+
+class nonatomic_count
+{
+public:
+    explicit nonatomic_count( long n ) noexcept
+        : count( n )
+    {}
+
+    void increment() noexcept
+    {
+        ++count;
+    }
+
+    bool decrement() noexcept
+    {
+        return --count == 0;
+    }
+
+    long use_count() const noexcept
+    {
+        return count;
+    }
+
+private:
+    long count;
+};
+
+class atomic_count
+{
+public:
+    explicit atomic_count( long n ) noexcept
+        : count( n )
+    {}
+
+    // A new owner can only be created from an existing one, so no ordering is needed:
+
+    void increment() noexcept
+    {
+        count.fetch_add( 1, std::memory_order_relaxed );
+    }
+
+    // Release our writes, acquire the other owners' writes before the deleter runs.
+    // A sole owner cannot race with anyone, so it skips the read-modify-write:
+
+    bool decrement() noexcept
+    {
+        if ( count.load( std::memory_order_acquire ) == 1 )
+            return true;
+
+        return count.fetch_sub( 1, std::memory_order_acq_rel ) == 1;
+    }
+
+    long use_count() const noexcept
+    {
+        return count.load( std::memory_order_relaxed );
+    }
+
+private:
+    std::atomic<long> count;
+};
+
+// shared_resource: count, resource handle and deleter in a single allocation.
+
+template< class R, class D, class CountPolicy = atomic_count >
+class shared_resource
+{
+public:
+    typedef unique_resource<R, D> unique_resource_type;
+    typedef CountPolicy count_policy;
+
+private:
+    struct control_block
+    {
+        explicit control_block( unique_resource_type && r )
+            : count( 1 )
+            , resource( std::move( r ) )
+        {}
+
+        CountPolicy count;
+        unique_resource_type resource;
+    };
+
+public:
+    shared_resource() noexcept
+        : block( nullptr )
+    {}
+
+    // Since C++17 the control block is allocated before its argument is evaluated, so
+    // own the resource first; if allocation fails, it is deleted if execute is true:
+
+    template< class RR, class DD >
+    shared_resource( RR && r, DD && d, bool execute = true )
+        : shared_resource( unique_resource_type( std::forward<RR>( r ), std::forward<DD>( d ), execute ) )
+    {}
+
+    // Take over ownership from r; if allocation fails, r is left untouched:
+
+    shared_resource( unique_resource_type && r )
+        : block( new control_block( std::move( r ) ) )
+    {}
+
+    shared_resource( shared_resource const & other ) noexcept
+        : block( other.block )
+    {
+        if ( block )
+            block->count.increment();
+    }
+
+    shared_resource( shared_resource && other ) noexcept
+        : block( other.block )
+    {
+        other.block = nullptr;
+    }
+
+    ~shared_resource()
+    {
+        reset();
+    }
+
+    shared_resource & operator=( shared_resource const & other ) noexcept
+    {
+        shared_resource( other ).swap( *this );
+        return *this;
+    }
+
+    shared_resource & operator=( shared_resource && other ) noexcept
+    {
+        shared_resource( std::move( other ) ).swap( *this );
+        return *this;
+    }
+
+    shared_resource & operator=( unique_resource_type && r )
+    {
+        shared_resource( std::move( r ) ).swap( *this );
+        return *this;
+    }
+
+    // Give up this owner's share; the last owner executes the deleter:
+
+    void reset() noexcept
+    {
+        if ( block && block->count.decrement() )
+            delete block;
+
+        block = nullptr;
+    }
+
+    void swap( shared_resource & other ) noexcept
+    {
+        std::swap( block, other.block );
+    }
+
+    auto get() const noexcept -> decltype( std::declval<unique_resource_type const &>().get() )
+    {
+        return block->resource.get();
+    }
+
+    template< class RR = R >
+    auto operator*() const noexcept ->
+        typename std::enable_if<
+            std::is_pointer<RR>::value && !std::is_void<typename std::remove_pointer<RR>::type>::value
+            , typename std::add_lvalue_reference<typename std::remove_pointer<RR>::type>::type
+        >::type
+    {
+        return *get();
+    }
+
+    template< class RR = R >
+    auto operator->() const noexcept -> typename std::enable_if< std::is_pointer<RR>::value, RR >::type
+    {
+        return get();
+    }
+
+    D const & get_deleter() const noexcept
+    {
+        return block->resource.get_deleter();
+    }
+
+    long use_count() const noexcept
+    {
+        return block ? block->count.use_count() : 0;
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return block != nullptr;
+    }
+
+private:
+    control_block * block;
+};
+
+template< class R, class D, class CountPolicy >
+void swap( shared_resource<R, D, CountPolicy> & a, shared_resource<R, D, CountPolicy> & b ) noexcept
+{
+    a.swap( b );
+}
+
+// factory function make_shared_resource_checked(), see make_unique_resource_checked():
+
+template< class CountPolicy = atomic_count, class R, class D, class S = typename std::decay<R>::type >
+shared_resource< typename std::decay<R>::type, typename std::decay<D>::type, CountPolicy >
+make_shared_resource_checked( R && resource, S const & invalid, D && deleter )
+{
+    return shared_resource< typename std::decay<R>::type, typename std::decay<D>::type, CountPolicy >(
+        make_unique_resource_checked( std::forward<R>( resource ), invalid, std::forward<D>( deleter ) ) );
+}
+
+}} // namespace nonstd::scope
+
+namespace nonstd
+{
+    using scope::nonatomic_count;
+    using scope::atomic_count;
+    using scope::shared_resource;
+    using scope::make_shared_resource_checked;
+}
+
+#endif // scope_HAVE_SHARED_RESOURCE
+
+#endif // NONSTD_SCOPE_SHARED_RESOURCE_HPP
@@ -0,0 +1,421 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Non-standard extension: teardown_plan and teardown_group, release named groups
+// of resources in dependency order, independent groups in parallel.
+
+#ifndef NONSTD_SCOPE_TEARDOWN_GROUP_HPP
+#define NONSTD_SCOPE_TEARDOWN_GROUP_HPP
+
+#include "../scope.hpp"
+
+#define scope_HAVE_TEARDOWN_GROUP  ( scope_CPP11_OR_GREATER && !scope_CONFIG_NO_EXTENSIONS )
+
+#if scope_HAVE_TEARDOWN_GROUP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace nonstd {
+namespace scope {
+
+class teardown_plan;
+
+// teardown_group: a named group of exit actions and resources, released in reverse
+// order of registration. Actions and deleters must not throw.
+
+class teardown_group
+{
+public:
+    // Register an exit function, as a scope_exit would run it:
+
+    template< class EF >
+    teardown_group & add( EF && exit_function )
+    {
+        actions.emplace_back( new action_impl<scope_exit<typename std::decay<EF>::type>>( std::forward<EF>( exit_function ) ) );
+        return *this;
+    }
+
+    // Take over a resource, e.g. a unique_resource, that is released by its destructor:
+
+    template< class Resource >
+    teardown_group & adopt( Resource && resource )
+    {
+        static_assert( !std::is_lvalue_reference<Resource>::value, "adopt() takes over the resource: pass an rvalue" );
+
+        actions.emplace_back( new action_impl<Resource>( std::move( resource ) ) );
+        return *this;
+    }
+
+    // This group is torn down before the named group, e.g. as it uses that group's resources:
+
+    teardown_group & depends_on( std::string const & group_name );
+
+    std::string const & name() const noexcept
+    {
+        return group_name;
+    }
+
+    std::size_t size() const noexcept
+    {
+        return actions.size();
+    }
+
+    teardown_group( teardown_group const & ) = delete;
+    teardown_group & operator=( teardown_group const & ) = delete;
+
+private:
+    friend class teardown_plan;
+
+    struct action
+    {
+        virtual ~action() {}
+    };
+
+    template< class T >
+    struct action_impl : action
+    {
+        template< class U >
+        explicit action_impl( U && u )
+            : held( std::forward<U>( u ) )
+        {}
+
+        T held;
+    };
+
+    teardown_group( teardown_plan & p, std::string const & n )
+        : plan( &p )
+        , group_name( n )
+        , dependents( 0 )
+        , waiting_for( 0 )
+    {}
+
+    void run() noexcept
+    {
+        while ( !actions.empty() )
+            actions.pop_back();
+    }
+
+    teardown_plan * plan;
+    std::string group_name;
+    std::vector< std::unique_ptr<action> > actions;
+    std::vector< teardown_group * > dependencies;
+    std::size_t dependents;
+    std::atomic<std::size_t> waiting_for;
+};
+
+// Timing of a group's teardown:
+
+struct teardown_report
+{
+    std::string name;
+    std::size_t actions;
+    std::chrono::steady_clock::duration duration;
+};
+
+// teardown_plan: owns the groups; teardown() releases them.
+//
+// - a group is torn down after all groups that depend on it,
+// - independent groups are torn down in parallel, by the calling thread and up to
+//   threads - 1 helper threads, which take ready groups from each other's queues,
+// - a dependency cycle makes teardown() throw std::logic_error before it releases anything,
+// - the destructor tears down groups that are still registered.
+
+class teardown_plan
+{
+public:
+    teardown_plan() {}
+
+    ~teardown_plan()
+    {
+        try
+        {
+            teardown( 1 );
+        }
+        catch ( ... )
+        {
+            // dependency cycle: release the groups in reverse order of creation:
+
+            for ( auto g = groups.rbegin(); g != groups.rend(); ++g )
+                (*g)->run();
+        }
+    }
+
+    // The group with the given name, created on first use:
+
+    teardown_group & group( std::string const & name )
+    {
+        for ( auto & g : groups )
+        {
+            if ( g->name() == name )
+                return *g;
+        }
+
+        groups.emplace_back( new teardown_group( *this, name ) );
+        return *groups.back();
+    }
+
+    static std::size_t default_threads() noexcept
+    {
+        std::size_t const n = std::thread::hardware_concurrency();
+        return n == 0 ? 1 : n < 4 ? n : 4;
+    }
+
+    // Release all groups; returns the timing per group, in order of group creation:
+
+    std::vector<teardown_report> teardown( std::size_t threads = default_threads() )
+    {
+        check_acyclic();
+
+        std::vector<teardown_report> reports;
+        reports.reserve( groups.size() );
+
+        for ( auto & g : groups )
+            reports.push_back( teardown_report{ g->name(), g->size(), std::chrono::steady_clock::duration() } );
+
+        if ( groups.empty() )
+            return reports;
+
+        if ( threads == 0 )
+            threads = 1;
+
+        if ( threads > groups.size() )
+            threads = groups.size();
+
+        pool p( *this, reports, threads );
+
+        for ( auto & g : groups )
+            g->waiting_for.store( g->dependents, std::memory_order_relaxed );
+
+        std::size_t next = 0;
+
+        for ( auto & g : groups )
+        {
+            if ( g->dependents == 0 )
+                p.push( next++ % threads, g.get() );
+        }
+
+        p.run();
+
+        groups.clear();
+        return reports;
+    }
+
+    teardown_plan( teardown_plan const & ) = delete;
+    teardown_plan & operator=( teardown_plan const & ) = delete;
+
+private:
+    friend class teardown_group;
+
+    // Work-stealing pool: a worker pops its own queue from the back, and steals from
+    // the front of other queues; a finished group makes its dependencies ready on the
+    // queue of the worker that finished it.
+
+    class pool
+    {
+    public:
+        pool( teardown_plan & p, std::vector<teardown_report> & r, std::size_t threads )
+            : plan( p )
+            , reports( r )
+            , queues( threads )
+            , ready( 0 )
+            , remaining( p.groups.size() )
+        {}
+
+        void push( std::size_t worker, teardown_group * g )
+        {
+            {
+                std::lock_guard<std::mutex> lock( queues[ worker ].mutex );
+                queues[ worker ].groups.push_back( g );
+            }
+
+            ready.fetch_add( 1, std::memory_order_seq_cst );
+
+            std::lock_guard<std::mutex> lock( idle_mutex );
+            idle_cv.notify_one();
+        }
+
+        void run()
+        {
+            std::vector<std::thread> helpers;
+
+            // Without helpers, the remaining workers steal the helper's groups:
+
+            try
+            {
+                for ( std::size_t i = 1; i < queues.size(); ++i )
+                    helpers.emplace_back( [this, i]{ work( i ); } );
+            }
+            catch ( std::exception const & ) {}
+
+            work( 0 );
+
+            for ( auto & h : helpers )
+                h.join();
+        }
+
+    private:
+        struct queue
+        {
+            std::mutex mutex;
+            std::deque<teardown_group *> groups;
+        };
+
+        void work( std::size_t self )
+        {
+            while ( remaining.load( std::memory_order_seq_cst ) > 0 )
+            {
+                if ( teardown_group * g = take( self ) )
+                {
+                    execute( self, g );
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock( idle_mutex );
+                idle_cv.wait( lock, [this]{
+                    return ready.load( std::memory_order_seq_cst ) > 0 || remaining.load( std::memory_order_seq_cst ) == 0; } );
+            }
+        }
+
+        teardown_group * take( std::size_t self )
+        {
+            for ( std::size_t k = 0; k < queues.size(); ++k )
+            {
+                std::size_t const i = ( self + k ) % queues.size();
+                std::lock_guard<std::mutex> lock( queues[ i ].mutex );
+
+                if ( queues[ i ].groups.empty() )
+                    continue;
+
+                teardown_group * g = nullptr;
+
+                if ( i == self )
+                {
+                    g = queues[ i ].groups.back();
+                    queues[ i ].groups.pop_back();
+                }
+                else
+                {
+                    g = queues[ i ].groups.front();
+                    queues[ i ].groups.pop_front();
+                }
+
+                ready.fetch_sub( 1, std::memory_order_seq_cst );
+                return g;
+            }
+            return nullptr;
+        }
+
+        void execute( std::size_t self, teardown_group * g )
+        {
+            auto const start = std::chrono::steady_clock::now();
+            g->run();
+            reports[ plan.index_of( g ) ].duration = std::chrono::steady_clock::now() - start;
+
+            for ( teardown_group * d : g->dependencies )
+            {
+                if ( d->waiting_for.fetch_sub( 1, std::memory_order_acq_rel ) == 1 )
+                    push( self, d );
+            }
+
+            if ( remaining.fetch_sub( 1, std::memory_order_seq_cst ) == 1 )
+            {
+                std::lock_guard<std::mutex> lock( idle_mutex );
+                idle_cv.notify_all();
+            }
+        }
+
+        teardown_plan & plan;
+        std::vector<teardown_report> & reports;
+        std::vector<queue> queues;
+        std::atomic<std::size_t> ready;
+        std::atomic<std::size_t> remaining;
+        std::mutex idle_mutex;
+        std::condition_variable idle_cv;
+    };
+
+    std::size_t index_of( teardown_group const * g ) const noexcept
+    {
+        std::size_t i = 0;
+        while ( groups[ i ].get() != g )
+            ++i;
+        return i;
+    }
+
+    // Kahn's algorithm: all groups can be torn down, if none is left waiting.
+
+    void check_acyclic() const
+    {
+        std::vector<std::size_t> waiting;
+        std::vector<teardown_group const *> ready;
+
+        for ( auto & g : groups )
+        {
+            waiting.push_back( g->dependents );
+
+            if ( g->dependents == 0 )
+                ready.push_back( g.get() );
+        }
+
+        std::size_t done = 0;
+
+        while ( !ready.empty() )
+        {
+            teardown_group const * g = ready.back();
+            ready.pop_back();
+            ++done;
+
+            for ( teardown_group * d : g->dependencies )
+            {
+                if ( --waiting[ index_of( d ) ] == 0 )
+                    ready.push_back( d );
+            }
+        }
+
+        if ( done != groups.size() )
+            throw std::logic_error( "teardown_plan: dependency cycle between groups" );
+    }
+
+    std::vector< std::unique_ptr<teardown_group> > groups;
+};
+
+inline teardown_group & teardown_group::depends_on( std::string const & group_name )
+{
+    teardown_group & other = plan->group( group_name );
+
+    if ( &other == this )
+        throw std::logic_error( "teardown_group: a group cannot depend on itself" );
+
+    dependencies.push_back( &other );
+    ++other.dependents;
+    return *this;
+}
+
+}} // namespace nonstd::scope
+
+namespace nonstd
+{
+    using scope::teardown_group;
+    using scope::teardown_plan;
+    using scope::teardown_report;
+}
+
+#endif // scope_HAVE_TEARDOWN_GROUP
+
+#endif // NONSTD_SCOPE_TEARDOWN_GROUP_HPP
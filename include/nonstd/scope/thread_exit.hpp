@@ -0,0 +1,236 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Non-standard extension: on_thread_exit() and scope_thread_exit, one per-thread
+// LIFO list of scope_exit actions that runs when the thread exits.
+
+#ifndef NONSTD_SCOPE_THREAD_EXIT_HPP
+#define NONSTD_SCOPE_THREAD_EXIT_HPP
+
+#include "../scope.hpp"
+
+#define scope_HAVE_THREAD_EXIT  ( scope_CPP11_OR_GREATER && !scope_CONFIG_NO_EXTENSIONS )
+
+// Number of actions per thread that are stored without allocation:
+
+#ifndef  scope_CONFIG_THREAD_EXIT_CAPACITY
+# define scope_CONFIG_THREAD_EXIT_CAPACITY  16
+#endif
+
+// Size of the storage for one action, including its bookkeeping:
+
+#ifndef  scope_CONFIG_THREAD_EXIT_SLOT_SIZE
+# define scope_CONFIG_THREAD_EXIT_SLOT_SIZE  64
+#endif
+
+#if scope_HAVE_THREAD_EXIT
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace nonstd {
+namespace scope {
+
+// scope_thread_exit: the calling thread's list of exit actions.
+//
+// - push() registers an action as a scope_exit; actions run in reverse order of registration,
+// - the first scope_CONFIG_THREAD_EXIT_CAPACITY actions that fit a slot are stored inline,
+//   later or larger actions are allocated,
+// - actions run when the thread exits, or earlier at execute(), e.g. between the tasks
+//   of a pooled worker thread; an action may register further actions,
+// - an action registered after the thread's list was destroyed runs immediately.
+
+class scope_thread_exit
+{
+public:
+    enum { capacity  = scope_CONFIG_THREAD_EXIT_CAPACITY };
+    enum { slot_size = scope_CONFIG_THREAD_EXIT_SLOT_SIZE };
+
+    template< class EF >
+    static void push( EF && exit_function )
+    {
+        typedef entry_impl<typename std::decay<EF>::type> entry_type;
+
+        if ( state() == exited )
+        {
+            entry_type run_now( std::forward<EF>( exit_function ) );
+            return;
+        }
+
+        typedef std::integral_constant<bool,
+            sizeof( entry_type ) <= slot_size && alignof( entry_type ) <= alignof( std::max_align_t ) > fits_slot;
+
+        scope_thread_exit & list = instance();
+
+        entry * e = list.create<entry_type>( std::forward<EF>( exit_function ), fits_slot() );
+
+        e->below = list.top;
+        list.top = e;
+    }
+
+    // Run the calling thread's actions now, most recently registered first:
+
+    static void execute() noexcept
+    {
+        if ( state() == active )
+            instance().run();
+    }
+
+    // Number of the calling thread's registered actions:
+
+    static std::size_t size() noexcept
+    {
+        if ( state() != active )
+            return 0;
+
+        return instance().inline_count + instance().heap_count;
+    }
+
+    ~scope_thread_exit()
+    {
+        run();
+        state() = exited;
+    }
+
+    scope_thread_exit( scope_thread_exit const & ) = delete;
+    scope_thread_exit & operator=( scope_thread_exit const & ) = delete;
+
+private:
+    enum thread_state { unused, active, exited };
+
+    struct entry
+    {
+        entry()
+            : below( nullptr )
+            , is_inline( false )
+        {}
+
+        virtual ~entry() {}
+
+        entry * below;
+        bool is_inline;
+    };
+
+    // Destroying the entry destroys its scope_exit, which runs the action:
+
+    template< class EF >
+    struct entry_impl : entry
+    {
+        template< class Fn >
+        explicit entry_impl( Fn && fn )
+            : guard( std::forward<Fn>( fn ) )
+        {}
+
+        scope_exit<EF> guard;
+    };
+
+    struct slot
+    {
+        alignas( std::max_align_t ) unsigned char data[ slot_size ];
+    };
+
+    template< class Entry, class Fn >
+    entry * create( Fn && fn, std::true_type )
+    {
+        if ( inline_count < capacity && heap_count == 0 && !running )
+        {
+            entry * e = ::new( static_cast<void *>( slots[ inline_count ].data ) ) Entry( std::forward<Fn>( fn ) );
+            e->is_inline = true;
+            ++inline_count;
+            return e;
+        }
+
+        return create<Entry>( std::forward<Fn>( fn ), std::false_type() );
+    }
+
+    template< class Entry, class Fn >
+    entry * create( Fn && fn, std::false_type )
+    {
+        entry * e = new Entry( std::forward<Fn>( fn ) );
+        ++heap_count;
+        return e;
+    }
+
+    scope_thread_exit() noexcept
+        : inline_count( 0 )
+        , heap_count( 0 )
+        , top( nullptr )
+        , running( false )
+    {
+        state() = active;
+    }
+
+    static scope_thread_exit & instance() noexcept
+    {
+        thread_local scope_thread_exit list;
+        return list;
+    }
+
+    // Trivially destructible, so it stays valid while other thread_locals are destroyed:
+
+    static thread_state & state() noexcept
+    {
+        thread_local thread_state s = unused;
+        return s;
+    }
+
+    // Actions may register further actions while the list runs; these are allocated,
+    // as the inline slots are only reused once the list is empty:
+
+    void run() noexcept
+    {
+        running = true;
+
+        while ( entry * e = top )
+        {
+            top = e->below;
+
+            if ( e->is_inline )
+            {
+                --inline_count;
+                e->~entry();
+            }
+            else
+            {
+                --heap_count;
+                delete e;
+            }
+        }
+
+        running = false;
+    }
+
+private:
+    slot slots[ capacity ];
+    std::size_t inline_count;
+    std::size_t heap_count;
+    entry * top;
+    bool running;
+};
+
+// Register exit_function to run when the calling thread exits:
+
+template< class EF >
+void on_thread_exit( EF && exit_function )
+{
+    scope_thread_exit::push( std::forward<EF>( exit_function ) );
+}
+
+}} // namespace nonstd::scope
+
+namespace nonstd
+{
+    using scope::scope_thread_exit;
+    using scope::on_thread_exit;
+}
+
+#endif // scope_HAVE_THREAD_EXIT
+
+#endif // NONSTD_SCOPE_THREAD_EXIT_HPP
@@ -0,0 +1,60 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Non-standard extension: type_name<T>(), the readable name of a type, e.g. of a
+// unique_resource in a report; demangled where the ABI supports it.
+
+#ifndef NONSTD_SCOPE_TYPE_NAME_HPP
+#define NONSTD_SCOPE_TYPE_NAME_HPP
+
+#include "../scope.hpp"
+
+#define scope_HAVE_TYPE_NAME  ( scope_CPP11_OR_GREATER && !scope_CONFIG_NO_EXTENSIONS )
+
+#if scope_HAVE_TYPE_NAME
+
+#if defined( __GNUG__ )
+# include <cxxabi.h>
+#endif
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <typeinfo>
+
+namespace nonstd {
+namespace scope {
+
+inline std::string type_name( std::type_info const & type )
+{
+#if defined( __GNUG__ )
+    int status = 0;
+    std::unique_ptr<char, void(*)(void*)> name( abi::__cxa_demangle( type.name(), nullptr, nullptr, &status ), std::free );
+
+    if ( status == 0 && name )
+        return name.get();
+#endif
+    return type.name();
+}
+
+template< class T >
+std::string type_name()
+{
+    return type_name( typeid( T ) );
+}
+
+}} // namespace nonstd::scope
+
+namespace nonstd
+{
+    using scope::type_name;
+}
+
+#endif // scope_HAVE_TYPE_NAME
+
+#endif // NONSTD_SCOPE_TYPE_NAME_HPP
@@ -0,0 +1,479 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Non-standard extension: unique_child, a child process owned via a pidfd, which
+// is reaped without blocking, or by a shared reaper thread that polls many pidfds.
+
+#ifndef NONSTD_SCOPE_UNIQUE_CHILD_HPP
+#define NONSTD_SCOPE_UNIQUE_CHILD_HPP
+
+#include "unique_fd.hpp"
+
+#define scope_HAVE_UNIQUE_CHILD  ( scope_HAVE_UNIQUE_FD && scope_HAVE_LINUX )
+
+#if scope_HAVE_UNIQUE_CHILD
+
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+namespace nonstd {
+namespace scope {
+
+namespace detail {
+
+// pidfd_open() and pidfd_send_signal() appeared in Linux 5.3 and 5.1, waitid( P_PIDFD ) in 5.4:
+
+inline int pidfd_open( pid_t pid ) noexcept
+{
+#if defined( __NR_pidfd_open )
+    return static_cast<int>( ::syscall( __NR_pidfd_open, pid, 0U ) );
+#else
+    (void) pid;
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+
+inline bool pidfd_send_signal( int pidfd, int sig ) noexcept
+{
+#if defined( __NR_pidfd_send_signal )
+    return ::syscall( __NR_pidfd_send_signal, pidfd, sig, nullptr, 0U ) == 0;
+#else
+    (void) pidfd; (void) sig;
+    errno = ENOSYS;
+    return false;
+#endif
+}
+
+inline bool pid_wait( pid_t pid, int options, int & status ) noexcept
+{
+    int s = 0;
+    pid_t r;
+
+    while ( ( r = ::waitpid( pid, &s, options ) ) < 0 && errno == EINTR )
+        ;
+
+    if ( r != pid )
+        return false;
+
+    status = s;
+    return true;
+}
+
+// Wait for the child pid of pidfd to exit; returns true with its waitpid()-style status
+// if it was reaped, false if it still runs (WNOHANG) or on error, with errno set.
+// Linux 5.3 has pidfds but rejects waitid( P_PIDFD ) with EINVAL; then wait via pid:
+
+inline bool pidfd_wait( int pidfd, pid_t pid, int options, int & status ) noexcept
+{
+    idtype_t const p_pidfd = static_cast<idtype_t>( 3 );
+
+    siginfo_t info;
+    std::memset( &info, 0, sizeof( info ) );
+
+    while ( ::waitid( p_pidfd, static_cast<id_t>( pidfd ), &info, WEXITED | options ) != 0 )
+    {
+        if ( errno == EINVAL )
+            return pid_wait( pid, options, status );
+
+        if ( errno != EINTR )
+            return false;
+    }
+
+    if ( info.si_pid == 0 )
+        return false;
+
+    switch ( info.si_code )
+    {
+        case CLD_EXITED: status = ( info.si_status & 0xff ) << 8; break;
+        case CLD_DUMPED: status = info.si_status | 0x80; break;
+        default:         status = info.si_status; break;
+    }
+    return true;
+}
+
+} // namespace detail
+
+// child_reaper: a thread that reaps exited children, waiting for all pidfds it was
+// given with one epoll instance. The thread starts at the first adopt(); the destructor
+// stops it and closes the pidfds of children that did not exit yet, which the system
+// then reaps when this process exits.
+
+class child_reaper
+{
+public:
+    child_reaper() noexcept
+        : epoll_fd( ::epoll_create1( EPOLL_CLOEXEC ) )
+        , wake_fd( ::eventfd( 0, EFD_CLOEXEC | EFD_NONBLOCK ) )
+        , stopping( false )
+        , reaped_children( 0 )
+    {
+        // Without its wake_fd, the worker could not be stopped:
+
+        if ( !epoll_fd || !wake_fd )
+        {
+            epoll_fd.reset();
+            return;
+        }
+
+        epoll_event ev;
+        std::memset( &ev, 0, sizeof( ev ) );
+        ev.events  = EPOLLIN;
+        ev.data.fd = wake_fd.get();
+
+        if ( ::epoll_ctl( epoll_fd.get(), EPOLL_CTL_ADD, wake_fd.get(), &ev ) != 0 )
+            epoll_fd.reset();
+    }
+
+    ~child_reaper()
+    {
+        if ( worker.joinable() )
+        {
+            stopping.store( true, std::memory_order_release );
+            wake();
+            worker.join();
+        }
+
+        for ( auto const & child : pending_children )
+            ::close( child.first );
+    }
+
+    // Take over the pidfd of child pid, to reap it when it exits; false if the reaper
+    // is not available, and then pidfd still owns its descriptor:
+
+    bool adopt( unique_fd && pidfd, pid_t pid ) noexcept
+    {
+        if ( !epoll_fd || !pidfd )
+            return false;
+
+        std::lock_guard<std::mutex> lock( mutex );
+
+        try
+        {
+            if ( !worker.joinable() )
+                worker = std::thread( [this]{ run(); } );
+
+            pending_children.emplace( pidfd.get(), pid );
+        }
+        catch ( std::exception const & )
+        {
+            return false;
+        }
+
+        epoll_event ev;
+        std::memset( &ev, 0, sizeof( ev ) );
+        ev.events  = EPOLLIN;
+        ev.data.fd = pidfd.get();
+
+        if ( ::epoll_ctl( epoll_fd.get(), EPOLL_CTL_ADD, pidfd.get(), &ev ) != 0 )
+        {
+            pending_children.erase( pidfd.get() );
+            return false;
+        }
+
+        pidfd.release();
+        return true;
+    }
+
+    // Number of children that were adopted, and did not exit yet:
+
+    std::size_t pending() const
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        return pending_children.size();
+    }
+
+    // Number of children reaped so far:
+
+    std::size_t reaped() const noexcept
+    {
+        return reaped_children.load( std::memory_order_acquire );
+    }
+
+    child_reaper( child_reaper const & ) = delete;
+    child_reaper & operator=( child_reaper const & ) = delete;
+
+private:
+    void wake() noexcept
+    {
+        std::uint64_t const one = 1;
+        ssize_t const n = ::write( wake_fd.get(), &one, sizeof( one ) );
+        (void) n;
+    }
+
+    void run() noexcept
+    {
+        epoll_event events[ 32 ];
+
+        while ( !stopping.load( std::memory_order_acquire ) )
+        {
+            int const n = ::epoll_wait( epoll_fd.get(), events, 32, -1 );
+
+            if ( n < 0 && errno != EINTR )
+                return;
+
+            for ( int i = 0; i < n; ++i )
+            {
+                if ( events[ i ].data.fd != wake_fd.get() )
+                    reap( events[ i ].data.fd );
+            }
+        }
+    }
+
+    // A pidfd becomes readable when its child exits. On an error, the pidfd is no longer
+    // watched, as it would stay readable; ECHILD means the child was reaped elsewhere:
+
+    void reap( int pidfd ) noexcept
+    {
+        pid_t pid = 0;
+
+        {
+            std::lock_guard<std::mutex> lock( mutex );
+            auto const child = pending_children.find( pidfd );
+
+            if ( child != pending_children.end() )
+                pid = child->second;
+        }
+
+        int status = 0;
+        errno = 0;
+
+        bool const reaped = detail::pidfd_wait( pidfd, pid, WNOHANG, status );
+        int const error = errno;
+
+        if ( !reaped && error == 0 )
+            return;
+
+        ::epoll_ctl( epoll_fd.get(), EPOLL_CTL_DEL, pidfd, nullptr );
+
+        {
+            std::lock_guard<std::mutex> lock( mutex );
+            pending_children.erase( pidfd );
+        }
+
+        ::close( pidfd );
+
+        if ( reaped || error == ECHILD )
+            reaped_children.fetch_add( 1, std::memory_order_release );
+    }
+
+    unique_fd epoll_fd;
+    unique_fd wake_fd;
+    std::atomic<bool> stopping;
+    std::atomic<std::size_t> reaped_children;
+    mutable std::mutex mutex;
+    std::unordered_map<int, pid_t> pending_children;    // by pidfd
+    std::thread worker;
+};
+
+inline child_reaper & default_child_reaper() noexcept
+{
+    static child_reaper reaper;
+    return reaper;
+}
+
+// unique_child: owns a child process via its pidfd.
+//
+// - try_wait() reaps the child if it exited, without blocking; status() then gives
+//   its waitpid()-style status, for WIFEXITED() and friends,
+// - if the child was not reaped, destruction applies the release policy:
+//   - reap_in_background: the child's reaper reaps it when it exits, the default,
+//   - kill_and_reap: send SIGKILL and reap it here, which waits briefly,
+//   - kill_and_reap_in_background: send SIGKILL and let the reaper reap it,
+//   if the reaper is not available, the child is reaped here, which may block.
+
+class unique_child
+{
+public:
+    enum release_policy
+    {
+        reap_in_background,
+        kill_and_reap,
+        kill_and_reap_in_background,
+    };
+
+    unique_child() noexcept
+        : child_pid( -1 )
+        , wait_status( 0 )
+        , exited( false )
+        , policy( reap_in_background )
+        , reaper( nullptr )
+    {}
+
+    unique_child( unique_child && other ) noexcept
+        : pidfd( std::move( other.pidfd ) )
+        , child_pid( other.child_pid )
+        , wait_status( other.wait_status )
+        , exited( other.exited )
+        , policy( other.policy )
+        , reaper( other.reaper )
+    {
+        other.child_pid = -1;
+        other.exited = false;
+    }
+
+    unique_child & operator=( unique_child && other ) noexcept
+    {
+        if ( this != &other )
+        {
+            reset();
+            pidfd       = std::move( other.pidfd );
+            child_pid   = other.child_pid;
+            wait_status = other.wait_status;
+            exited      = other.exited;
+            policy      = other.policy;
+            reaper      = other.reaper;
+            other.child_pid = -1;
+            other.exited = false;
+        }
+        return *this;
+    }
+
+    ~unique_child()
+    {
+        reset();
+    }
+
+    // Release the child according to the release policy, unless it was reaped:
+
+    void reset() noexcept
+    {
+        if ( pidfd && !exited )
+        {
+            if ( policy != reap_in_background )
+                kill( SIGKILL );
+
+            if ( policy == kill_and_reap || !reaper->adopt( std::move( pidfd ), child_pid ) )
+                wait();
+        }
+
+        pidfd.reset();
+        child_pid = -1;
+        exited = false;
+    }
+
+    // true if the child exited and was reaped; does not block:
+
+    bool try_wait() noexcept
+    {
+        if ( pidfd && !exited )
+            exited = detail::pidfd_wait( pidfd.get(), child_pid, WNOHANG, wait_status );
+
+        return exited;
+    }
+
+    // Wait for the child to exit, and reap it:
+
+    bool wait() noexcept
+    {
+        if ( pidfd && !exited )
+            exited = detail::pidfd_wait( pidfd.get(), child_pid, 0, wait_status );
+
+        return exited;
+    }
+
+    bool has_exited() const noexcept
+    {
+        return exited;
+    }
+
+    // The waitpid()-style status of a child that exited:
+
+    int status() const noexcept
+    {
+        return wait_status;
+    }
+
+    bool kill( int sig = SIGTERM ) const noexcept
+    {
+        return !exited && detail::pidfd_send_signal( pidfd.get(), sig );
+    }
+
+    pid_t pid() const noexcept
+    {
+        return child_pid;
+    }
+
+    int get() const noexcept
+    {
+        return pidfd.get();
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return !!pidfd;
+    }
+
+    release_policy get_release_policy() const noexcept
+    {
+        return policy;
+    }
+
+    unique_child( unique_child const & ) = delete;
+    unique_child & operator=( unique_child const & ) = delete;
+
+private:
+    friend unique_child make_unique_child( pid_t pid, release_policy policy, child_reaper & reaper ) noexcept;
+
+    unique_fd pidfd;
+    pid_t child_pid;
+    int wait_status;
+    bool exited;
+    release_policy policy;
+    child_reaper * reaper;
+};
+
+// Own child process pid, e.g. as returned by fork(); the result owns nothing on
+// failure, with errno set, e.g. ENOSYS before Linux 5.3:
+
+inline unique_child make_unique_child(
+    pid_t pid
+    , unique_child::release_policy policy = unique_child::reap_in_background
+    , child_reaper & reaper = default_child_reaper() ) noexcept
+{
+    unique_child child;
+    child.pidfd.reset( detail::pidfd_open( pid ) );
+
+    if ( child.pidfd )
+    {
+        child.child_pid = pid;
+        child.policy    = policy;
+        child.reaper    = &reaper;
+    }
+    return child;
+}
+
+}} // namespace nonstd::scope
+
+namespace nonstd
+{
+    using scope::child_reaper;
+    using scope::default_child_reaper;
+    using scope::unique_child;
+    using scope::make_unique_child;
+}
+
+#endif // scope_HAVE_UNIQUE_CHILD
+
+#endif // NONSTD_SCOPE_UNIQUE_CHILD_HPP
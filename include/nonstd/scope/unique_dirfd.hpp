@@ -0,0 +1,123 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Non-standard extension: unique_dirfd, an open directory that opens, creates
+// and removes files relative to itself, via openat(), mkdirat() and unlinkat().
+
+#ifndef NONSTD_SCOPE_UNIQUE_DIRFD_HPP
+#define NONSTD_SCOPE_UNIQUE_DIRFD_HPP
+
+#include "unique_fd.hpp"
+
+#define scope_HAVE_UNIQUE_DIRFD  scope_HAVE_UNIQUE_FD
+
+#if scope_HAVE_UNIQUE_DIRFD
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <utility>
+
+namespace nonstd {
+namespace scope {
+
+// unique_dirfd: owns a descriptor of a directory. Paths given to its members are
+// resolved relative to the directory, which saves the kernel the walk of the
+// directory's own path on every open; absolute paths are used as is.
+//
+// - the resources that members return own nothing on failure, with errno set, like
+//   make_unique_resource_checked( fd, -1, close_fd() ) does,
+// - descriptors are opened with O_CLOEXEC, unless stated otherwise.
+
+class unique_dirfd
+{
+public:
+    unique_dirfd() noexcept {}
+
+    // Takes ownership of descriptor dirfd of a directory, unless it is -1:
+
+    explicit unique_dirfd( int dirfd ) noexcept
+        : fd( dirfd )
+    {}
+
+    // Open file path, with openat() flags and mode; flags are used as given:
+
+    unique_fd open( char const * path, int flags, mode_t mode = 0666 ) const noexcept
+    {
+        return unique_fd( ::openat( fd.get(), path, flags, mode ) );
+    }
+
+    // Open subdirectory path:
+
+    unique_dirfd open_directory( char const * path ) const noexcept
+    {
+        return unique_dirfd( ::openat( fd.get(), path, O_RDONLY | O_DIRECTORY | O_CLOEXEC ) );
+    }
+
+    // Create subdirectory path, if it does not exist, and open it:
+
+    unique_dirfd make_directory( char const * path, mode_t mode = 0777 ) const noexcept
+    {
+        if ( ::mkdirat( fd.get(), path, mode ) != 0 && errno != EEXIST )
+            return unique_dirfd();
+
+        return open_directory( path );
+    }
+
+    // Remove file path, or with AT_REMOVEDIR, empty directory path:
+
+    bool unlink( char const * path, int flags = 0 ) const noexcept
+    {
+        return ::unlinkat( fd.get(), path, flags ) == 0;
+    }
+
+    void reset() noexcept
+    {
+        fd.reset();
+    }
+
+    void release() noexcept
+    {
+        fd.release();
+    }
+
+    int get() const noexcept
+    {
+        return fd.get();
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return !!fd;
+    }
+
+private:
+    unique_fd fd;
+};
+
+// Open directory path, relative to the current working directory:
+
+inline unique_dirfd open_directory( char const * path ) noexcept
+{
+    return unique_dirfd( ::openat( AT_FDCWD, path, O_RDONLY | O_DIRECTORY | O_CLOEXEC ) );
+}
+
+}} // namespace nonstd::scope
+
+namespace nonstd
+{
+    using scope::unique_dirfd;
+    using scope::open_directory;
+}
+
+#endif // scope_HAVE_UNIQUE_DIRFD
+
+#endif // NONSTD_SCOPE_UNIQUE_DIRFD_HPP
@@ -0,0 +1,313 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Non-standard extension: unique_fd, a POSIX file descriptor that is -1 when it
+// owns nothing, and unique_fd_set, which closes runs of descriptors via close_range().
+
+#ifndef NONSTD_SCOPE_UNIQUE_FD_HPP
+#define NONSTD_SCOPE_UNIQUE_FD_HPP
+
+#include "../scope.hpp"
+
+#if defined( __has_include )
+# if __has_include( <unistd.h> )
+#  define scope_HAVE_UNISTD_H  1
+# endif
+#endif
+
+#ifndef  scope_HAVE_UNISTD_H
+# define scope_HAVE_UNISTD_H  0
+#endif
+
+#if defined( __linux__ )
+# define scope_HAVE_LINUX  1
+#else
+# define scope_HAVE_LINUX  0
+#endif
+
+#define scope_HAVE_UNIQUE_FD  ( scope_CPP11_OR_GREATER && !scope_CONFIG_NO_EXTENSIONS && scope_HAVE_UNISTD_H )
+
+#if scope_HAVE_UNIQUE_FD
+
+#if scope_HAVE_LINUX
+# include <sys/syscall.h>
+#endif
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace nonstd {
+namespace scope {
+
+// close_fd: the deleter of unique_fd. A close() interrupted by a signal is not
+// retried: on Linux the descriptor is released regardless, and may already be reused.
+
+struct close_fd
+{
+    void operator()( int fd ) const noexcept
+    {
+        ::close( fd );
+    }
+};
+
+// unique_fd: owns a file descriptor, like unique_resource<int, close_fd>, with -1 as
+// the value that owns nothing, instead of a separate flag; it is the size of an int.
+
+class unique_fd
+{
+public:
+    unique_fd() noexcept
+        : fd( -1 )
+    {}
+
+    // Takes ownership of fd, unless it is -1, e.g. a failed open():
+
+    explicit unique_fd( int fd_ ) noexcept
+        : fd( fd_ )
+    {}
+
+    unique_fd( unique_fd && other ) noexcept
+        : fd( other.fd )
+    {
+        other.fd = -1;
+    }
+
+    unique_fd & operator=( unique_fd && other ) noexcept
+    {
+        if ( this != &other )
+        {
+            reset();
+            fd = other.fd;
+            other.fd = -1;
+        }
+        return *this;
+    }
+
+    ~unique_fd()
+    {
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        if ( fd != -1 )
+        {
+            close_fd()( fd );
+            fd = -1;
+        }
+    }
+
+    void reset( int fd_ ) noexcept
+    {
+        reset();
+        fd = fd_;
+    }
+
+    void release() noexcept
+    {
+        fd = -1;
+    }
+
+    int get() const noexcept
+    {
+        return fd;
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return fd != -1;
+    }
+
+    close_fd get_deleter() const noexcept
+    {
+        return close_fd();
+    }
+
+    unique_fd( unique_fd const & ) = delete;
+    unique_fd & operator=( unique_fd const & ) = delete;
+
+private:
+    int fd;
+};
+
+namespace detail {
+
+// close_range() appeared in Linux 5.9; closing the range [~0U, ~0U] probes for it without effect:
+
+inline bool has_close_range() noexcept
+{
+#if defined( __NR_close_range )
+    static bool const available = ::syscall( __NR_close_range, ~0U, ~0U, 0U ) == 0;
+    return available;
+#else
+    return false;
+#endif
+}
+
+inline bool close_range( int first, int last ) noexcept
+{
+#if defined( __NR_close_range )
+    return has_close_range()
+        && ::syscall( __NR_close_range, static_cast<unsigned>( first ), static_cast<unsigned>( last ), 0U ) == 0;
+#else
+    (void) first; (void) last;
+    return false;
+#endif
+}
+
+} // namespace detail
+
+// unique_fd_set: owns a set of file descriptors, e.g. the connections of a worker.
+//
+// - close_all() and the destructor sort the descriptors and close each run of consecutive
+//   descriptors with one close_range() call; a single descriptor is closed with close(),
+// - without close_range(), e.g. on kernels before Linux 5.9 or other systems, every
+//   descriptor is closed with close(),
+// - a descriptor added more than once is closed once.
+
+class unique_fd_set
+{
+public:
+    unique_fd_set() {}
+
+    unique_fd_set( unique_fd_set && other ) noexcept
+        : fds( std::move( other.fds ) )
+    {
+        other.fds.clear();
+    }
+
+    unique_fd_set & operator=( unique_fd_set && other ) noexcept
+    {
+        if ( this != &other )
+        {
+            close_all();
+            fds.swap( other.fds );
+        }
+        return *this;
+    }
+
+    ~unique_fd_set()
+    {
+        close_all();
+    }
+
+    // Take over fd; if the set cannot grow, fd still owns its descriptor:
+
+    void adopt( unique_fd && fd )
+    {
+        if ( !fd )
+            return;
+
+        fds.push_back( fd.get() );
+        fd.release();
+    }
+
+    // Take over descriptor fd; if the set cannot grow, fd is closed:
+
+    void insert( int fd )
+    {
+        adopt( unique_fd( fd ) );
+    }
+
+    // Give up ownership of descriptor fd, if the set owns it:
+
+    unique_fd take( int fd )
+    {
+        std::vector<int>::iterator pos = std::find( fds.begin(), fds.end(), fd );
+
+        if ( pos == fds.end() )
+            return unique_fd();
+
+        fds.erase( std::remove( pos, fds.end(), fd ), fds.end() );
+        return unique_fd( fd );
+    }
+
+    bool contains( int fd ) const
+    {
+        return std::find( fds.begin(), fds.end(), fd ) != fds.end();
+    }
+
+    std::size_t size() const noexcept
+    {
+        return fds.size();
+    }
+
+    bool empty() const noexcept
+    {
+        return fds.empty();
+    }
+
+    void reserve( std::size_t n )
+    {
+        fds.reserve( n );
+    }
+
+    // Close all descriptors; returns the number of system calls used:
+
+    std::size_t close_all() noexcept
+    {
+        std::sort( fds.begin(), fds.end() );
+        fds.erase( std::unique( fds.begin(), fds.end() ), fds.end() );
+
+        std::size_t calls = 0;
+
+        for ( std::size_t first = 0; first < fds.size(); )
+        {
+            std::size_t last = first;
+
+            while ( last + 1 < fds.size() && fds[ last + 1 ] == fds[ last ] + 1 )
+                ++last;
+
+            if ( last > first && detail::close_range( fds[ first ], fds[ last ] ) )
+            {
+                ++calls;
+            }
+            else
+            {
+                for ( std::size_t i = first; i <= last; ++i )
+                    close_fd()( fds[ i ] );
+
+                calls += last - first + 1;
+            }
+
+            first = last + 1;
+        }
+
+        fds.clear();
+        return calls;
+    }
+
+    // true if close_all() can close a run of descriptors with one close_range():
+
+    static bool has_close_range() noexcept
+    {
+        return detail::has_close_range();
+    }
+
+    unique_fd_set( unique_fd_set const & ) = delete;
+    unique_fd_set & operator=( unique_fd_set const & ) = delete;
+
+private:
+    std::vector<int> fds;
+};
+
+}} // namespace nonstd::scope
+
+namespace nonstd
+{
+    using scope::close_fd;
+    using scope::unique_fd;
+    using scope::unique_fd_set;
+}
+
+#endif // scope_HAVE_UNIQUE_FD
+
+#endif // NONSTD_SCOPE_UNIQUE_FD_HPP
@@ -0,0 +1,397 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Non-standard extension: unique_mapping, a memory-mapped region that owns its
+// address and length, and is released via munmap().
+
+#ifndef NONSTD_SCOPE_UNIQUE_MAPPING_HPP
+#define NONSTD_SCOPE_UNIQUE_MAPPING_HPP
+
+#include "../scope.hpp"
+
+#if defined( __has_include )
+# if __has_include( <sys/mman.h> )
+#  define scope_HAVE_SYS_MMAN_H  1
+# endif
+#endif
+
+#ifndef  scope_HAVE_SYS_MMAN_H
+# define scope_HAVE_SYS_MMAN_H  0
+#endif
+
+#define scope_HAVE_UNIQUE_MAPPING  ( scope_CPP11_OR_GREATER && !scope_CONFIG_NO_EXTENSIONS && scope_HAVE_SYS_MMAN_H )
+
+// Size of an explicit or transparent huge page, to which such mappings are rounded and aligned:
+
+#ifndef  scope_CONFIG_HUGE_PAGE_SIZE
+# define scope_CONFIG_HUGE_PAGE_SIZE  ( 2u * 1024u * 1024u )
+#endif
+
+#if scope_HAVE_UNIQUE_MAPPING
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+
+namespace nonstd {
+namespace scope {
+
+// unmap_region: a deleter of a mapping of length bytes, for unique_resource<void *, unmap_region>;
+// unlike unique_mapping, such a resource also tells the scope_CONFIG_HOOKS policy of its release:
+
+struct unmap_region
+{
+    unmap_region() noexcept
+        : length( 0 )
+    {}
+
+    explicit unmap_region( std::size_t n ) noexcept
+        : length( n )
+    {}
+
+    void operator()( void * p ) const noexcept
+    {
+        ::munmap( p, length );
+    }
+
+    std::size_t length;
+};
+
+// unique_mapping: owns the memory-mapped region [data(), data() + size()), and unmaps it
+// with munmap() on destruction. A null address owns nothing; it is the size of two pointers.
+
+class unique_mapping
+{
+public:
+    // Options of make_anonymous_mapping() and make_file_mapping(); options that a
+    // system does not support are ignored:
+
+    enum options : unsigned
+    {
+        map_populate               = 1u << 0,   // MAP_POPULATE: prefault the page tables
+        map_transparent_huge_pages = 1u << 1,   // anonymous: align to and advise MADV_HUGEPAGE
+        map_huge_pages             = 1u << 2,   // anonymous: MAP_HUGETLB, else transparent huge pages
+        map_locked                 = 1u << 3,   // mlock(): the mapping fails if the pages cannot be locked
+        map_copy_on_write          = 1u << 4,   // file: MAP_PRIVATE instead of MAP_SHARED
+        advise_sequential          = 1u << 5,   // MADV_SEQUENTIAL
+        advise_random              = 1u << 6,   // MADV_RANDOM
+        advise_willneed            = 1u << 7,   // MADV_WILLNEED
+    };
+
+    enum advice
+    {
+        normal,
+        sequential,
+        random,
+        willneed,
+        dontneed,
+    };
+
+    unique_mapping() noexcept
+        : addr( nullptr )
+        , len( 0 )
+    {}
+
+    // Takes ownership of the mapping [p, p + length), unless p is null:
+
+    unique_mapping( void * p, std::size_t length ) noexcept
+        : addr( p )
+        , len( p ? length : 0 )
+    {}
+
+    unique_mapping( unique_mapping && other ) noexcept
+        : addr( other.addr )
+        , len( other.len )
+    {
+        other.release();
+    }
+
+    unique_mapping & operator=( unique_mapping && other ) noexcept
+    {
+        if ( this != &other )
+        {
+            reset();
+            addr = other.addr;
+            len  = other.len;
+            other.release();
+        }
+        return *this;
+    }
+
+    ~unique_mapping()
+    {
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        if ( addr )
+        {
+            ::munmap( addr, len );
+            release();
+        }
+    }
+
+    void reset( void * p, std::size_t length ) noexcept
+    {
+        reset();
+        addr = p;
+        len  = p ? length : 0;
+    }
+
+    void release() noexcept
+    {
+        addr = nullptr;
+        len  = 0;
+    }
+
+    void * get() const noexcept
+    {
+        return addr;
+    }
+
+    unsigned char * data() const noexcept
+    {
+        return static_cast<unsigned char *>( addr );
+    }
+
+    // The length of the mapping, which a huge-page mapping rounds up to whole huge pages:
+
+    std::size_t size() const noexcept
+    {
+        return len;
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return addr != nullptr;
+    }
+
+    // Advise the kernel on the use of the range [offset, offset + length), by default all of it:
+
+    bool advise( advice a, std::size_t offset = 0, std::size_t length = std::size_t( -1 ) ) const noexcept
+    {
+        if ( !addr || offset >= len )
+            return false;
+
+        if ( length > len - offset )
+            length = len - offset;
+
+        return ::madvise( data() + offset, length, to_madvise( a ) ) == 0;
+    }
+
+    // Keep the pages in memory, e.g. for latency-critical regions; see RLIMIT_MEMLOCK:
+
+    bool lock() const noexcept
+    {
+        return addr && ::mlock( addr, len ) == 0;
+    }
+
+    bool unlock() const noexcept
+    {
+        return addr && ::munlock( addr, len ) == 0;
+    }
+
+    unique_mapping( unique_mapping const & ) = delete;
+    unique_mapping & operator=( unique_mapping const & ) = delete;
+
+private:
+    static int to_madvise( advice a ) noexcept
+    {
+        switch ( a )
+        {
+            case sequential: return MADV_SEQUENTIAL;
+            case random:     return MADV_RANDOM;
+            case willneed:   return MADV_WILLNEED;
+            case dontneed:   return MADV_DONTNEED;
+            default:         return MADV_NORMAL;
+        }
+    }
+
+private:
+    void * addr;
+    std::size_t len;
+};
+
+namespace detail {
+
+inline std::size_t round_up( std::size_t n, std::size_t multiple ) noexcept
+{
+    return ( n + multiple - 1 ) / multiple * multiple;
+}
+
+inline void * mmap_or_null( std::size_t length, int prot, int flags, int fd, off_t offset ) noexcept
+{
+    void * const p = ::mmap( nullptr, length, prot, flags, fd, offset );
+    return p == MAP_FAILED ? nullptr : p;
+}
+
+// Map length bytes at an address aligned to a huge page, by mapping a huge page
+// more and unmapping the excess at both ends:
+
+inline void * mmap_huge_aligned( std::size_t length, int prot, int flags ) noexcept
+{
+    std::size_t const huge = scope_CONFIG_HUGE_PAGE_SIZE;
+
+    unsigned char * const p = static_cast<unsigned char *>( mmap_or_null( length + huge, prot, flags, -1, 0 ) );
+
+    if ( p == nullptr )
+        return nullptr;
+
+    std::uintptr_t const start = reinterpret_cast<std::uintptr_t>( p );
+    unsigned char * const aligned = p + ( round_up( start, huge ) - start );
+
+    if ( aligned != p )
+        ::munmap( p, static_cast<std::size_t>( aligned - p ) );
+
+    std::size_t const tail = static_cast<std::size_t>( ( p + length + huge ) - ( aligned + length ) );
+
+    if ( tail > 0 )
+        ::munmap( aligned + length, tail );
+
+    return aligned;
+}
+
+// Prefault the pages of an anonymous mapping, by touching them if MADV_POPULATE_WRITE,
+// of Linux 5.14, is not available:
+
+inline void populate( void * p, std::size_t length ) noexcept
+{
+#if defined( MADV_POPULATE_WRITE )
+    if ( ::madvise( p, length, MADV_POPULATE_WRITE ) == 0 )
+        return;
+#endif
+    std::size_t const page = static_cast<std::size_t>( ::sysconf( _SC_PAGESIZE ) );
+    volatile unsigned char * const bytes = static_cast<unsigned char *>( p );
+
+    for ( std::size_t i = 0; i < length; i += page )
+        bytes[ i ] = 0;
+}
+
+// Apply the advice and locking options; on failure, unmap and keep errno:
+
+inline unique_mapping finish_mapping( void * p, std::size_t length, unsigned options ) noexcept
+{
+    unique_mapping m( p, length );
+
+    if ( !m )
+        return m;
+
+    if ( options & unique_mapping::advise_sequential ) m.advise( unique_mapping::sequential );
+    if ( options & unique_mapping::advise_random     ) m.advise( unique_mapping::random );
+    if ( options & unique_mapping::advise_willneed   ) m.advise( unique_mapping::willneed );
+
+    if ( ( options & unique_mapping::map_locked ) && !m.lock() )
+    {
+        int const error = errno;
+        m.reset();
+        errno = error;
+    }
+
+    return m;
+}
+
+} // namespace detail
+
+// Map length bytes of zero-initialized, private memory; the result owns nothing on
+// failure, with errno set. Explicit huge pages fall back to transparent huge pages,
+// e.g. when no huge pages are reserved.
+
+inline unique_mapping make_anonymous_mapping( std::size_t length, unsigned options = 0 ) noexcept
+{
+    int const prot = PROT_READ | PROT_WRITE;
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+#if defined( MAP_POPULATE )
+    if ( options & unique_mapping::map_populate )
+        flags |= MAP_POPULATE;
+#endif
+
+    if ( options & unique_mapping::map_huge_pages )
+    {
+#if defined( MAP_HUGETLB )
+        std::size_t const huge_length = detail::round_up( length, scope_CONFIG_HUGE_PAGE_SIZE );
+
+        if ( void * p = detail::mmap_or_null( huge_length, prot, flags | MAP_HUGETLB, -1, 0 ) )
+            return detail::finish_mapping( p, huge_length, options );
+#endif
+        options |= unique_mapping::map_transparent_huge_pages;
+    }
+
+    if ( options & unique_mapping::map_transparent_huge_pages )
+    {
+        std::size_t const huge_length = detail::round_up( length, scope_CONFIG_HUGE_PAGE_SIZE );
+
+        // Advise before prefaulting, so that populating uses huge pages:
+
+        void * const p = detail::mmap_huge_aligned( huge_length, prot, MAP_PRIVATE | MAP_ANONYMOUS );
+
+        if ( p == nullptr )
+            return unique_mapping();
+#if defined( MADV_HUGEPAGE )
+        ::madvise( p, huge_length, MADV_HUGEPAGE );
+#endif
+        if ( options & unique_mapping::map_populate )
+            detail::populate( p, huge_length );
+
+        return detail::finish_mapping( p, huge_length, options );
+    }
+
+    return detail::finish_mapping( detail::mmap_or_null( length, prot, flags, -1, 0 ), length, options );
+}
+
+// Map length bytes of file fd from offset, which must be a multiple of the page size;
+// a length of 0 maps the file from offset up to its end. The mapping is shared, unless
+// map_copy_on_write is given. The result owns nothing on failure, with errno set; an
+// empty range fails with EINVAL.
+
+inline unique_mapping make_file_mapping( int fd, std::size_t length = 0, int prot = PROT_READ, unsigned options = 0, off_t offset = 0 ) noexcept
+{
+    if ( length == 0 )
+    {
+        struct stat st;
+
+        if ( ::fstat( fd, &st ) != 0 )
+            return unique_mapping();
+
+        length = st.st_size > offset ? static_cast<std::size_t>( st.st_size - offset ) : 0;
+    }
+
+    if ( length == 0 )
+    {
+        errno = EINVAL;
+        return unique_mapping();
+    }
+
+    int flags = ( options & unique_mapping::map_copy_on_write ) ? MAP_PRIVATE : MAP_SHARED;
+
+#if defined( MAP_POPULATE )
+    if ( options & unique_mapping::map_populate )
+        flags |= MAP_POPULATE;
+#endif
+
+    return detail::finish_mapping( detail::mmap_or_null( length, prot, flags, fd, offset ), length, options );
+}
+
+}} // namespace nonstd::scope
+
+namespace nonstd
+{
+    using scope::unmap_region;
+    using scope::unique_mapping;
+    using scope::make_anonymous_mapping;
+    using scope::make_file_mapping;
+}
+
+#endif // scope_HAVE_UNIQUE_MAPPING
+
+#endif // NONSTD_SCOPE_UNIQUE_MAPPING_HPP
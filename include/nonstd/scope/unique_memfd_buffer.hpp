@@ -0,0 +1,212 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Non-standard extension: unique_memfd_buffer, a shared memory buffer created via
+// memfd_create(), that can be sealed and handed to consumers as read-only mappings.
+
+#ifndef NONSTD_SCOPE_UNIQUE_MEMFD_BUFFER_HPP
+#define NONSTD_SCOPE_UNIQUE_MEMFD_BUFFER_HPP
+
+#include "unique_fd.hpp"
+#include "unique_mapping.hpp"
+
+#define scope_HAVE_UNIQUE_MEMFD_BUFFER  ( scope_HAVE_UNIQUE_FD && scope_HAVE_UNIQUE_MAPPING && scope_HAVE_LINUX )
+
+#if scope_HAVE_UNIQUE_MEMFD_BUFFER
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <utility>
+
+namespace nonstd {
+namespace scope {
+
+// unique_memfd_buffer: owns a memfd of a fixed size, and a writable shared mapping of it,
+// as a unique_resource<int, close_fd> and a unique_resource<void *, unmap_region>.
+//
+// - the memfd lives as long as a descriptor or a mapping of it exists: readers may keep
+//   their mappings, and consumers their descriptors, after the buffer is destroyed,
+// - map_read_only() maps the buffer for a consumer; duplicate() gives a descriptor to
+//   hand to a subprocess or another component, which maps it via make_file_mapping(),
+// - seal() adds F_SEAL_* seals; seal_write requires that no writable mapping exists:
+//   unmap() the producer's mapping first, or seal with seal_future_write, Linux 5.1.
+
+class unique_memfd_buffer
+{
+public:
+    enum seals : unsigned
+    {
+        seal_seal         = F_SEAL_SEAL,    // no further seals
+        seal_shrink       = F_SEAL_SHRINK,  // the size cannot decrease
+        seal_grow         = F_SEAL_GROW,    // the size cannot increase
+        seal_write        = F_SEAL_WRITE,   // the contents cannot change
+#if defined( F_SEAL_FUTURE_WRITE )
+        seal_future_write = F_SEAL_FUTURE_WRITE,  // no new writes or writable mappings
+#endif
+        seal_immutable    = F_SEAL_SEAL | F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE,
+    };
+
+    unique_memfd_buffer() noexcept
+        : fd( no_fd() )
+        , length( 0 )
+    {}
+
+    // The producer's writable mapping; null after unmap():
+
+    unsigned char * data() const noexcept
+    {
+        return static_cast<unsigned char *>( writable.get() );
+    }
+
+    std::size_t size() const noexcept
+    {
+        return length;
+    }
+
+    int get() const noexcept
+    {
+        return fd.get();
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return fd.get() >= 0;
+    }
+
+    // Release the producer's writable mapping, e.g. before seal( seal_write ):
+
+    void unmap() noexcept
+    {
+        writable = mapping_resource();
+    }
+
+    // Add seals; fails with EBUSY for seal_write while a writable mapping exists,
+    // and with EPERM once seal_seal is set:
+
+    bool seal( unsigned seals_to_add ) const noexcept
+    {
+        return ::fcntl( fd.get(), F_ADD_SEALS, seals_to_add ) == 0;
+    }
+
+    unsigned sealed() const noexcept
+    {
+        int const s = ::fcntl( fd.get(), F_GET_SEALS );
+        return s < 0 ? 0u : static_cast<unsigned>( s );
+    }
+
+    // A read-only mapping of the whole buffer, independent of the buffer's lifetime:
+
+    unique_mapping map_read_only( unsigned options = 0 ) const noexcept
+    {
+        return make_file_mapping( fd.get(), length, PROT_READ, options & ~unique_mapping::map_copy_on_write );
+    }
+
+    // A descriptor of the memfd, e.g. to pass to a subprocess:
+
+    unique_fd duplicate() const noexcept
+    {
+        return unique_fd( ::fcntl( fd.get(), F_DUPFD_CLOEXEC, 0 ) );
+    }
+
+    unique_memfd_buffer( unique_memfd_buffer && other ) noexcept
+        : fd( std::move( other.fd ) )
+        , writable( std::move( other.writable ) )
+        , length( other.length )
+    {
+        other.clear();
+    }
+
+    unique_memfd_buffer & operator=( unique_memfd_buffer && other ) noexcept
+    {
+        if ( this != &other )
+        {
+            writable = std::move( other.writable );
+            fd       = std::move( other.fd );
+            length   = other.length;
+            other.clear();
+        }
+        return *this;
+    }
+
+    unique_memfd_buffer( unique_memfd_buffer const & ) = delete;
+    unique_memfd_buffer & operator=( unique_memfd_buffer const & ) = delete;
+
+private:
+    friend unique_memfd_buffer make_memfd_buffer( char const * name, std::size_t size, unsigned options ) noexcept;
+
+    using fd_resource      = unique_resource<int, close_fd>;
+    using mapping_resource = unique_resource<void *, unmap_region>;
+
+    static fd_resource no_fd() noexcept
+    {
+        return fd_resource( -1, close_fd(), false );
+    }
+
+    // Leave a moved-from buffer owning nothing, with get() -1 and data() null:
+
+    void clear() noexcept
+    {
+        writable = mapping_resource();
+        fd       = no_fd();
+        length   = 0;
+    }
+
+    // The mapping is destroyed before the descriptor:
+
+    fd_resource fd;
+    mapping_resource writable;
+    std::size_t length;
+};
+
+// Create a sealable memfd of size bytes, named name for /proc/self/fd, and map it
+// writable with unique_mapping options; the result owns nothing on failure, with errno set.
+
+inline unique_memfd_buffer make_memfd_buffer( char const * name, std::size_t size, unsigned options = 0 ) noexcept
+{
+    unique_memfd_buffer buffer;
+    buffer.fd = make_unique_resource_checked( ::memfd_create( name, MFD_CLOEXEC | MFD_ALLOW_SEALING ), -1, close_fd() );
+
+    if ( !buffer || ::ftruncate( buffer.get(), static_cast<off_t>( size ) ) != 0 )
+    {
+        buffer.clear();
+        return buffer;
+    }
+
+    // make_file_mapping() applies the options; the buffer takes over its mapping:
+
+    unique_mapping writable = make_file_mapping( buffer.get(), size, PROT_READ | PROT_WRITE, options & ~unique_mapping::map_copy_on_write );
+
+    if ( !writable )
+    {
+        int const error = errno;
+        buffer.clear();
+        errno = error;
+        return buffer;
+    }
+
+    buffer.writable = unique_memfd_buffer::mapping_resource( writable.get(), unmap_region( writable.size() ) );
+    buffer.length   = size;
+    writable.release();
+    return buffer;
+}
+
+}} // namespace nonstd::scope
+
+namespace nonstd
+{
+    using scope::unique_memfd_buffer;
+    using scope::make_memfd_buffer;
+}
+
+#endif // scope_HAVE_UNIQUE_MEMFD_BUFFER
+
+#endif // NONSTD_SCOPE_UNIQUE_MEMFD_BUFFER_HPP
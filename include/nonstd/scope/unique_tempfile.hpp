@@ -0,0 +1,220 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Non-standard extension: unique_tempfile, a temporary file without a name, via
+// O_TMPFILE, that can be published under a name via linkat().
+
+#ifndef NONSTD_SCOPE_UNIQUE_TEMPFILE_HPP
+#define NONSTD_SCOPE_UNIQUE_TEMPFILE_HPP
+
+#include "unique_dirfd.hpp"
+
+#define scope_HAVE_UNIQUE_TEMPFILE  scope_HAVE_UNIQUE_DIRFD
+
+#if scope_HAVE_UNIQUE_TEMPFILE
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <string>
+#include <utility>
+
+namespace nonstd {
+namespace scope {
+
+// unique_tempfile: owns a temporary file, opened for reading and writing with mode 0600.
+//
+// - an anonymous temporary file, via O_TMPFILE, has no name: it disappears when it is
+//   closed, also when the process crashes,
+// - without O_TMPFILE, e.g. on file systems that do not support it, the file is created
+//   via mkstemp() under a temporary name, which the destructor removes,
+// - publish() gives the file its final name atomically: another process sees either
+//   no file, or the complete file. Like linkat(), it fails if the name exists.
+//
+// For a durable file, fsync() it before publishing, and fsync() its directory after.
+
+class unique_tempfile
+{
+public:
+    unique_tempfile() noexcept {}
+
+    unique_tempfile( unique_tempfile && other ) noexcept
+        : fd( std::move( other.fd ) )
+        , temp_name( std::move( other.temp_name ) )
+    {
+        other.temp_name.clear();
+    }
+
+    unique_tempfile & operator=( unique_tempfile && other ) noexcept
+    {
+        if ( this != &other )
+        {
+            reset();
+            fd = std::move( other.fd );
+            temp_name.swap( other.temp_name );
+        }
+        return *this;
+    }
+
+    ~unique_tempfile()
+    {
+        reset();
+    }
+
+    // Remove the file, unless it was published, and close it:
+
+    void reset() noexcept
+    {
+        if ( !temp_name.empty() )
+        {
+            ::unlink( temp_name.c_str() );
+            temp_name.clear();
+        }
+        fd.reset();
+    }
+
+    // Give the file the name path, relative to the current directory:
+
+    bool publish( char const * path ) noexcept
+    {
+        return publish_at( AT_FDCWD, path );
+    }
+
+    // Give the file the name path, relative to directory dir:
+
+    bool publish( unique_dirfd const & dir, char const * path ) noexcept
+    {
+        return publish_at( dir.get(), path );
+    }
+
+    int get() const noexcept
+    {
+        return fd.get();
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return !!fd;
+    }
+
+    // true if the file has no name, via O_TMPFILE:
+
+    bool is_anonymous() const noexcept
+    {
+        return !!fd && temp_name.empty();
+    }
+
+    // The temporary name of a file that is not anonymous, until it is published:
+
+    std::string const & temporary_name() const noexcept
+    {
+        return temp_name;
+    }
+
+    unique_tempfile( unique_tempfile const & ) = delete;
+    unique_tempfile & operator=( unique_tempfile const & ) = delete;
+
+private:
+    friend unique_tempfile make_named_tempfile( char const * directory ) noexcept;
+    friend unique_tempfile make_tempfile( char const * directory ) noexcept;
+
+    bool publish_at( int dirfd, char const * path ) noexcept
+    {
+        if ( !fd )
+        {
+            errno = EBADF;
+            return false;
+        }
+
+        if ( !temp_name.empty() )
+        {
+            if ( ::linkat( AT_FDCWD, temp_name.c_str(), dirfd, path, 0 ) != 0 )
+                return false;
+
+            ::unlink( temp_name.c_str() );
+            temp_name.clear();
+            return true;
+        }
+
+#if defined( AT_EMPTY_PATH )
+        // Requires CAP_DAC_READ_SEARCH; without it, link via /proc:
+
+        if ( ::linkat( fd.get(), "", dirfd, path, AT_EMPTY_PATH ) == 0 )
+            return true;
+
+        if ( errno != ENOENT && errno != EPERM )
+            return false;
+#endif
+        char proc_path[ 32 ];
+        std::snprintf( proc_path, sizeof( proc_path ), "/proc/self/fd/%d", fd.get() );
+
+        return ::linkat( AT_FDCWD, proc_path, dirfd, path, AT_SYMLINK_FOLLOW ) == 0;
+    }
+
+    unique_fd fd;
+    std::string temp_name;
+};
+
+// Create a temporary file in directory via mkstemp(), under a temporary name;
+// the result owns nothing on failure, with errno set:
+
+inline unique_tempfile make_named_tempfile( char const * directory ) noexcept
+{
+    unique_tempfile file;
+
+    try
+    {
+        std::string name = std::string( directory ) + "/.tmp-XXXXXX";
+
+        file.fd.reset( ::mkstemp( &name[ 0 ] ) );
+
+        if ( file.fd )
+        {
+            ::fcntl( file.fd.get(), F_SETFD, FD_CLOEXEC );
+            file.temp_name.swap( name );
+        }
+    }
+    catch ( ... )
+    {
+        file.reset();
+        errno = ENOMEM;
+    }
+
+    return file;
+}
+
+// Create an anonymous temporary file in directory via O_TMPFILE, or if that fails,
+// a named one via mkstemp(); the result owns nothing on failure, with errno set:
+
+inline unique_tempfile make_tempfile( char const * directory ) noexcept
+{
+#if defined( O_TMPFILE )
+    unique_tempfile file;
+    file.fd.reset( ::open( directory, O_TMPFILE | O_RDWR | O_CLOEXEC, 0600 ) );
+
+    if ( file.fd )
+        return file;
+#endif
+    return make_named_tempfile( directory );
+}
+
+}} // namespace nonstd::scope
+
+namespace nonstd
+{
+    using scope::unique_tempfile;
+    using scope::make_tempfile;
+    using scope::make_named_tempfile;
+}
+
+#endif // scope_HAVE_UNIQUE_TEMPFILE
+
+#endif // NONSTD_SCOPE_UNIQUE_TEMPFILE_HPP
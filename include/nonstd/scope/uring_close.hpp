@@ -0,0 +1,495 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Non-standard extension: uring_close_deleter, close file descriptors via
+// batched io_uring submissions instead of one close() system call each.
+
+#ifndef NONSTD_SCOPE_URING_CLOSE_HPP
+#define NONSTD_SCOPE_URING_CLOSE_HPP
+
+#include "../scope.hpp"
+
+#if defined( __linux__ ) && defined( __has_include )
+# if __has_include( <linux/io_uring.h> )
+#  define scope_HAVE_LINUX_IO_URING_H  1
+# endif
+#endif
+
+#ifndef  scope_HAVE_LINUX_IO_URING_H
+# define scope_HAVE_LINUX_IO_URING_H  0
+#endif
+
+#define scope_HAVE_URING_CLOSE  ( scope_CPP11_OR_GREATER && !scope_CONFIG_NO_EXTENSIONS && scope_HAVE_LINUX_IO_URING_H )
+
+// Number of submission queue entries of a thread's ring:
+
+#ifndef  scope_CONFIG_URING_QUEUE_DEPTH
+# define scope_CONFIG_URING_QUEUE_DEPTH  256
+#endif
+
+// Number of queued closes that triggers a submission:
+
+#ifndef  scope_CONFIG_URING_BATCH_SIZE
+# define scope_CONFIG_URING_BATCH_SIZE  32
+#endif
+
+#if scope_HAVE_URING_CLOSE
+
+#include <linux/io_uring.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+namespace nonstd {
+namespace scope {
+
+namespace detail {
+
+// A thread's io_uring, used for IORING_OP_CLOSE only. Set up on first use;
+// if the kernel refuses (no io_uring, seccomp, io_uring_disabled, or no
+// IORING_OP_CLOSE before Linux 5.6), every close falls back to close().
+//
+// The descriptors of queued closes are also kept in private memory: the rings
+// are shared with a forked child's parent, so only the private copy tells a
+// child which descriptors it inherited without a close.
+
+class uring_close_ring
+{
+public:
+    static uring_close_ring & instance() noexcept
+    {
+        thread_local uring_close_ring ring;
+        return ring;
+    }
+
+    bool is_available() noexcept
+    {
+        if ( ring_fd >= 0 && generation != fork_generation().load( std::memory_order_relaxed ) )
+            detach_after_fork();
+
+        return ring_fd >= 0;
+    }
+
+    void close( int fd ) noexcept
+    {
+        if ( !is_available() )
+        {
+            close_here( fd );
+            return;
+        }
+
+        io_uring_sqe * sqe = next_sqe();
+
+        if ( sqe == nullptr )
+        {
+            close_here( fd );
+            return;
+        }
+
+        std::memset( sqe, 0, sizeof( *sqe ) );
+        sqe->opcode    = IORING_OP_CLOSE;
+        sqe->fd        = fd;
+        sqe->user_data = static_cast<unsigned>( fd );
+
+        queued_fds[ local_tail & sq_mask ] = fd;
+
+        __atomic_store_n( sq_tail, ++local_tail, __ATOMIC_RELEASE );
+
+        if ( ++queued >= batch_size )
+            submit( 0 );
+    }
+
+    // Submit all queued closes and wait until they completed:
+
+    void flush() noexcept
+    {
+        if ( is_available() )
+            submit( queued + in_flight );
+    }
+
+    // Closes queued, but not yet submitted:
+
+    std::size_t pending() const noexcept
+    {
+        return queued;
+    }
+
+    // Closes that completed with an error, e.g. EBADF:
+
+    std::uint64_t failed_count() const noexcept
+    {
+        return failed;
+    }
+
+    ~uring_close_ring()
+    {
+        flush();
+
+        if ( is_available() )
+            detach();
+    }
+
+    uring_close_ring( uring_close_ring const & ) = delete;
+    uring_close_ring & operator=( uring_close_ring const & ) = delete;
+
+private:
+    uring_close_ring() noexcept
+        : ring_fd( -1 )
+        , queued_fds( nullptr )
+        , local_tail( 0 )
+        , batch_size( scope_CONFIG_URING_BATCH_SIZE )
+        , queued( 0 )
+        , in_flight( 0 )
+        , failed( 0 )
+        , generation( 0 )
+    {
+        setup();
+    }
+
+    // A forked child shares the parent's ring: its rings must not be used there.
+
+    static std::atomic<unsigned> & fork_generation() noexcept
+    {
+        static std::atomic<unsigned> instance( 0 );
+        return instance;
+    }
+
+    static void on_fork_child() noexcept
+    {
+        fork_generation().fetch_add( 1, std::memory_order_relaxed );
+    }
+
+    // IORING_OP_CLOSE and IORING_REGISTER_PROBE both exist from Linux 5.6; an older
+    // kernel rejects the probe, and would complete each close with EINVAL:
+
+    static bool supports_close( int fd ) noexcept
+    {
+        enum { probe_ops = IORING_OP_CLOSE + 1 };
+
+        alignas( io_uring_probe ) unsigned char buffer[ sizeof( io_uring_probe ) + probe_ops * sizeof( io_uring_probe_op ) ];
+        std::memset( buffer, 0, sizeof( buffer ) );
+
+        io_uring_probe * probe = reinterpret_cast<io_uring_probe *>( buffer );
+
+        if ( ::syscall( __NR_io_uring_register, fd, IORING_REGISTER_PROBE, probe, probe_ops ) < 0 )
+            return false;
+
+        return probe->last_op >= IORING_OP_CLOSE
+            && ( probe->ops[ IORING_OP_CLOSE ].flags & IO_URING_OP_SUPPORTED ) != 0;
+    }
+
+    void setup() noexcept
+    {
+        io_uring_params params;
+        std::memset( &params, 0, sizeof( params ) );
+
+        int const fd = static_cast<int>( ::syscall( __NR_io_uring_setup, scope_CONFIG_URING_QUEUE_DEPTH, &params ) );
+
+        if ( fd < 0 )
+            return;
+
+        if ( !supports_close( fd ) )
+        {
+            ::close( fd );
+            return;
+        }
+
+        static int const registered = ::pthread_atfork( nullptr, nullptr, &on_fork_child );
+
+        if ( registered != 0 )
+        {
+            ::close( fd );
+            return;
+        }
+
+        sq_ring_size = params.sq_off.array + params.sq_entries * sizeof( unsigned );
+        cq_ring_size = params.cq_off.cqes  + params.cq_entries * sizeof( io_uring_cqe );
+        sqes_size    = params.sq_entries * sizeof( io_uring_sqe );
+
+        bool const single_mmap = ( params.features & IORING_FEAT_SINGLE_MMAP ) != 0;
+
+        if ( single_mmap && cq_ring_size > sq_ring_size )
+            sq_ring_size = cq_ring_size;
+
+        sq_ring = map( fd, sq_ring_size, IORING_OFF_SQ_RING );
+        cq_ring = single_mmap ? sq_ring : map( fd, cq_ring_size, IORING_OFF_CQ_RING );
+        sqes    = static_cast<io_uring_sqe *>( map( fd, sqes_size, IORING_OFF_SQES ) );
+
+        queued_fds = new( std::nothrow ) int[ params.sq_entries ];
+
+        if ( sq_ring == nullptr || cq_ring == nullptr || sqes == nullptr || queued_fds == nullptr )
+        {
+            delete[] queued_fds;
+            queued_fds = nullptr;
+            if ( sq_ring ) ::munmap( sq_ring, sq_ring_size );
+            if ( cq_ring && cq_ring != sq_ring ) ::munmap( cq_ring, cq_ring_size );
+            if ( sqes ) ::munmap( sqes, sqes_size );
+            ::close( fd );
+            return;
+        }
+
+        unsigned char * sq = static_cast<unsigned char *>( sq_ring );
+        unsigned char * cq = static_cast<unsigned char *>( cq_ring );
+
+        sq_tail  = reinterpret_cast<unsigned *>( sq + params.sq_off.tail );
+        sq_head  = reinterpret_cast<unsigned *>( sq + params.sq_off.head );
+        sq_mask  = *reinterpret_cast<unsigned *>( sq + params.sq_off.ring_mask );
+        sq_array = reinterpret_cast<unsigned *>( sq + params.sq_off.array );
+        cq_head  = reinterpret_cast<unsigned *>( cq + params.cq_off.head );
+        cq_tail  = reinterpret_cast<unsigned *>( cq + params.cq_off.tail );
+        cq_mask  = *reinterpret_cast<unsigned *>( cq + params.cq_off.ring_mask );
+        cqes     = reinterpret_cast<io_uring_cqe *>( cq + params.cq_off.cqes );
+
+        sq_entries = params.sq_entries;
+        cq_entries = params.cq_entries;
+        local_tail = *sq_tail;
+
+        if ( batch_size > sq_entries )
+            batch_size = sq_entries;
+
+        generation = fork_generation().load( std::memory_order_relaxed );
+        ring_fd = fd;
+    }
+
+    static void * map( int fd, std::size_t size, unsigned long long offset ) noexcept
+    {
+        void * p = ::mmap( nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, static_cast<off_t>( offset ) );
+        return p == MAP_FAILED ? nullptr : p;
+    }
+
+    // The entry at the tail of the submission queue, to be published by advancing the tail;
+    // null if the submission queue is full, even after a submission:
+
+    io_uring_sqe * next_sqe() noexcept
+    {
+        unsigned const tail = local_tail;
+
+        if ( tail - __atomic_load_n( sq_head, __ATOMIC_ACQUIRE ) >= sq_entries )
+        {
+            submit( 0 );
+
+            if ( ring_fd < 0 || tail - __atomic_load_n( sq_head, __ATOMIC_ACQUIRE ) >= sq_entries )
+                return nullptr;
+        }
+
+        unsigned const index = tail & sq_mask;
+
+        sq_array[ index ] = index;
+        return &sqes[ index ];
+    }
+
+    // Submit queued entries and wait for at least wait_for completions. The completion
+    // queue holds 2 * sq_entries: keep the closes in flight below it, so it cannot overflow.
+
+    void submit( std::size_t wait_for ) noexcept
+    {
+        reap();
+
+        if ( in_flight + queued > cq_entries - sq_entries && wait_for < in_flight )
+            wait_for = in_flight;
+
+        while ( queued > 0 || wait_for > 0 )
+        {
+            unsigned const to_submit = static_cast<unsigned>( queued );
+            unsigned const min_complete = static_cast<unsigned>( wait_for < in_flight + queued ? wait_for : in_flight + queued );
+            unsigned const flags = min_complete > 0 ? IORING_ENTER_GETEVENTS : 0u;
+
+            long const n = ::syscall( __NR_io_uring_enter, ring_fd, to_submit, min_complete, flags, nullptr, 0 );
+
+            if ( n < 0 )
+            {
+                if ( errno == EINTR || errno == EAGAIN || errno == EBUSY )
+                {
+                    reap();
+                    continue;
+                }
+                abandon();
+                return;
+            }
+
+            queued    -= static_cast<std::size_t>( n );
+            in_flight += static_cast<std::size_t>( n );
+
+            std::size_t const done = reap();
+            wait_for = done >= wait_for ? 0 : wait_for - done;
+
+            if ( in_flight == 0 )
+                wait_for = 0;
+        }
+    }
+
+    std::size_t reap() noexcept
+    {
+        unsigned head = *cq_head;
+        unsigned const tail = __atomic_load_n( cq_tail, __ATOMIC_ACQUIRE );
+
+        std::size_t const done = tail - head;
+
+        for ( ; head != tail; ++head )
+        {
+            io_uring_cqe const & cqe = cqes[ head & cq_mask ];
+
+            if ( cqe.res >= 0 )
+                continue;
+
+            if ( is_still_open( -cqe.res ) )
+                close_here( static_cast<int>( cqe.user_data ) );
+            else
+                ++failed;
+        }
+
+        __atomic_store_n( cq_head, tail, __ATOMIC_RELEASE );
+
+        in_flight -= done;
+        return done;
+    }
+
+    // Whether a close that failed with error left the descriptor open, so that close()
+    // must be tried. Not so for EBADF, nor for the errors that close() too reports after
+    // it released the descriptor: retrying these could close a reused descriptor.
+
+    static bool is_still_open( int error ) noexcept
+    {
+        return error != EBADF && error != EINTR && error != EIO && error != ENOSPC && error != EDQUOT;
+    }
+
+    // The ring is unusable: the kernel no longer consumes entries, so queued
+    // closes are lost to it. Close them here, and use close() from now on.
+
+    void abandon() noexcept
+    {
+        unsigned const head = __atomic_load_n( sq_head, __ATOMIC_ACQUIRE );
+
+        for ( unsigned i = head; i != local_tail; ++i )
+            close_here( queued_fds[ i & sq_mask ] );
+
+        detach();
+    }
+
+    // A forked child: the closes queued at the fork were not submitted by the parent
+    // for the child's copies of the descriptors; close those here. Entries that were
+    // submitted are the parent's to complete.
+
+    void detach_after_fork() noexcept
+    {
+        for ( std::size_t i = queued; i > 0; --i )
+            close_here( queued_fds[ ( local_tail - static_cast<unsigned>( i ) ) & sq_mask ] );
+
+        detach();
+    }
+
+    void detach() noexcept
+    {
+        queued    = 0;
+        in_flight = 0;
+
+        ::munmap( sq_ring, sq_ring_size );
+        if ( cq_ring != sq_ring )
+            ::munmap( cq_ring, cq_ring_size );
+        ::munmap( sqes, sqes_size );
+        ::close( ring_fd );
+
+        delete[] queued_fds;
+        queued_fds = nullptr;
+        ring_fd = -1;
+    }
+
+    void close_here( int fd ) noexcept
+    {
+        if ( ::close( fd ) != 0 && errno != EINTR )
+            ++failed;
+    }
+
+private:
+    int ring_fd;
+    int * queued_fds;       // by submission queue index, private to this process
+    unsigned local_tail;    // the tail of the submission queue as published by this thread
+    std::size_t batch_size;
+    std::size_t queued;
+    std::size_t in_flight;
+    std::uint64_t failed;
+    unsigned generation;
+
+    void * sq_ring;
+    void * cq_ring;
+    io_uring_sqe * sqes;
+    std::size_t sq_ring_size;
+    std::size_t cq_ring_size;
+    std::size_t sqes_size;
+
+    unsigned * sq_head;
+    unsigned * sq_tail;
+    unsigned * sq_array;
+    unsigned   sq_mask;
+    unsigned   sq_entries;
+
+    unsigned * cq_head;
+    unsigned * cq_tail;
+    io_uring_cqe * cqes;
+    unsigned   cq_mask;
+    unsigned   cq_entries;
+};
+
+} // namespace detail
+
+// uring_close_deleter: queue the close of a file descriptor on the calling thread's
+// io_uring; the thread submits scope_CONFIG_URING_BATCH_SIZE closes at once, or on flush().
+// The descriptor stays open until its batch is submitted: flush() before an operation
+// that depends on the close, e.g. releasing a lock held via the descriptor.
+
+class uring_close_deleter
+{
+public:
+    void operator()( int fd ) const noexcept
+    {
+        detail::uring_close_ring::instance().close( fd );
+    }
+
+    // Submit the calling thread's queued closes and wait for them to complete:
+
+    static void flush() noexcept
+    {
+        detail::uring_close_ring::instance().flush();
+    }
+
+    // false if the calling thread falls back to close():
+
+    static bool is_available() noexcept
+    {
+        return detail::uring_close_ring::instance().is_available();
+    }
+
+    static std::size_t pending() noexcept
+    {
+        return detail::uring_close_ring::instance().pending();
+    }
+
+    static std::uint64_t failed_count() noexcept
+    {
+        return detail::uring_close_ring::instance().failed_count();
+    }
+};
+
+}} // namespace nonstd::scope
+
+namespace nonstd
+{
+    using scope::uring_close_deleter;
+}
+
+#endif // scope_HAVE_URING_CLOSE
+
+#endif // NONSTD_SCOPE_URING_CLOSE_HPP
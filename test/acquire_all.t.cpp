@@ -0,0 +1,126 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "scope-main.t.hpp"
+#include "nonstd/scope/acquire_all.hpp"
+
+#if scope_HAVE_ACQUIRE_ALL
+
+#include <atomic>
+#include <stdexcept>
+
+using namespace nonstd;
+
+namespace {
+
+std::atomic<int> opened( 0 );
+std::atomic<int> closed( 0 );
+
+int open_handle( int i )
+{
+    ++opened;
+    return i;
+}
+
+void close_handle( int )
+{
+    ++closed;
+}
+
+void reset_counts()
+{
+    opened = 0;
+    closed = 0;
+}
+
+} // anonymous namespace
+
+CASE( "acquire_all: returns a tuple of the acquired resources" " [extension][thread]" )
+{
+    reset_counts();
+
+    // scope:
+    {
+        auto all = acquire_all(
+            make_checked_acquisition( []{ return open_handle( 1 ); }, -1, close_handle ),
+            make_checked_acquisition( []{ return open_handle( 2 ); }, -1, close_handle ),
+            []{ return make_unique_resource_checked( open_handle( 3 ), -1, close_handle ); } );
+
+        EXPECT( std::get<0>( all ).get() == 1 );
+        EXPECT( std::get<1>( all ).get() == 2 );
+        EXPECT( std::get<2>( all ).get() == 3 );
+        EXPECT( closed == 0 );
+    }
+
+    EXPECT( opened == 3 );
+    EXPECT( closed == 3 );
+}
+
+CASE( "acquire_all: an invalid acquisition releases the others and throws acquisition_error" " [extension][thread]" )
+{
+    reset_counts();
+
+    try
+    {
+        auto all = acquire_all(
+            make_checked_acquisition( []{ return open_handle(  1 ); }, -1, close_handle ),
+            make_checked_acquisition( []{ return open_handle( -1 ); }, -1, close_handle ),
+            make_checked_acquisition( []{ return open_handle(  3 ); }, -1, close_handle ) );
+
+        EXPECT( !"acquire_all() should have thrown" );
+    }
+    catch ( acquisition_error const & e )
+    {
+        EXPECT( e.index() == 1u );
+    }
+
+    EXPECT( opened == 3 );
+    EXPECT( closed == 2 );
+}
+
+CASE( "acquire_all: a throwing acquisition releases the others and rethrows" " [extension][thread]" )
+{
+    reset_counts();
+
+    EXPECT_THROWS_AS(
+        acquire_all(
+            make_checked_acquisition( []{ return open_handle( 1 ); }, -1, close_handle ),
+            make_checked_acquisition( []() -> int { throw std::runtime_error( "open failed" ); }, -1, close_handle ) ),
+        std::runtime_error );
+
+    EXPECT( opened == 1 );
+    EXPECT( closed == 1 );
+}
+
+CASE( "acquire_all: many acquisitions share the threads" " [extension][thread]" )
+{
+    reset_counts();
+
+    auto const acquire = make_checked_acquisition( []{ return open_handle( 7 ); }, -1, close_handle );
+
+    // scope:
+    {
+        auto all = acquire_all( acquire, acquire, acquire, acquire, acquire, acquire, acquire, acquire );
+
+        EXPECT( std::get<7>( all ).get() == 7 );
+    }
+
+    EXPECT( opened == 8 );
+    EXPECT( closed == 8 );
+}
+
+#else // scope_HAVE_ACQUIRE_ALL
+
+CASE( "acquire_all: not available" " [extension]" )
+{
+    EXPECT( !!"acquire_all is not available (no C++11, or extensions disabled)." );
+}
+
+#endif // scope_HAVE_ACQUIRE_ALL
+
+// end of file
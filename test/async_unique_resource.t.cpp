@@ -0,0 +1,312 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "scope-main.t.hpp"
+#include "nonstd/scope/async_unique_resource.hpp"
+
+#if scope_HAVE_ASYNC_UNIQUE_RESOURCE
+
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace nonstd;
+
+namespace {
+
+std::string trace;
+
+// Runs submitted actions on request, like an event loop would:
+
+struct manual_executor
+{
+    void submit( std::function<void()> fn )
+    {
+        queue.push_back( std::move( fn ) );
+    }
+
+    void run()
+    {
+        std::vector< std::function<void()> > ready;
+        ready.swap( queue );
+
+        for ( auto & fn : ready )
+            fn();
+    }
+
+    std::vector< std::function<void()> > queue;
+};
+
+// An awaitable that suspends until set() resumes its awaiter:
+
+struct manual_event
+{
+    bool await_ready() const noexcept { return false; }
+    void await_suspend( std::coroutine_handle<> h ) noexcept { waiter = h; }
+    void await_resume() const noexcept {}
+
+    void set() { std::exchange( waiter, nullptr ).resume(); }
+
+    std::coroutine_handle<> waiter;
+};
+
+manual_event event;
+
+struct eager_task
+{
+    struct promise_type
+    {
+        eager_task get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+};
+
+async_task close_now( int i )
+{
+    trace += "close" + std::to_string( i );
+    co_return;
+}
+
+async_task close_later( int i )
+{
+    co_await event;
+    trace += "close" + std::to_string( i );
+}
+
+async_task close_throws( int )
+{
+    throw std::runtime_error( "close failed" );
+    co_return;
+}
+
+} // anonymous namespace
+
+CASE( "async_unique_resource: co_await async_reset() runs the deleter in the awaiting coroutine" " [extension]" )
+{
+    trace.clear();
+    manual_executor ex;
+
+    [&]() -> eager_task
+    {
+        async_unique_resource r( 7, close_now, ex );
+
+        co_await r.async_reset();
+        trace += "-after";
+    }();
+
+    EXPECT( trace == "close7-after" );
+    EXPECT( ex.queue.empty() );
+}
+
+CASE( "async_unique_resource: the awaiting coroutine resumes when the deleter completes" " [extension]" )
+{
+    trace.clear();
+    manual_executor ex;
+
+    [&]() -> eager_task
+    {
+        async_unique_resource r( 7, close_later, ex );
+
+        co_await r.async_reset();
+        trace += "-after";
+    }();
+
+    EXPECT( trace == "" );
+
+    event.set();
+
+    EXPECT( trace == "close7-after" );
+}
+
+CASE( "async_unique_resource: an exception from the deleter propagates to the awaiting coroutine" " [extension]" )
+{
+    trace.clear();
+    manual_executor ex;
+
+    [&]() -> eager_task
+    {
+        async_unique_resource r( 7, close_throws, ex );
+
+        try
+        {
+            co_await r.async_reset();
+        }
+        catch ( std::runtime_error const & e )
+        {
+            trace = e.what();
+        }
+    }();
+
+    EXPECT( trace == "close failed" );
+}
+
+CASE( "async_unique_resource: destruction without async_reset() schedules the deleter on the executor" " [extension]" )
+{
+    trace.clear();
+    manual_executor ex;
+
+    // scope:
+    {
+        async_unique_resource r( 7, close_later, ex );
+    }
+
+    EXPECT( ex.queue.size() == 1u );
+
+    ex.run();
+    EXPECT( trace == "" );
+
+    event.set();
+    EXPECT( trace == "close7" );
+}
+
+CASE( "async_unique_resource: a released resource is not deleted" " [extension]" )
+{
+    trace.clear();
+    manual_executor ex;
+
+    // scope:
+    {
+        async_unique_resource r( 7, close_now, ex );
+        r.release();
+    }
+
+    EXPECT( ex.queue.empty() );
+    EXPECT( trace == "" );
+}
+
+CASE( "async_unique_resource: a moved-from resource does not delete" " [extension]" )
+{
+    trace.clear();
+    manual_executor ex;
+
+    // scope:
+    {
+        async_unique_resource r1( 7, close_now, ex );
+        async_unique_resource r2( std::move( r1 ) );
+    }
+
+    ex.run();
+
+    EXPECT( trace == "close7" );
+}
+
+CASE( "async_unique_resource: the default executor is the default reclaimer" " [extension][thread]" )
+{
+    trace.clear();
+
+    // scope:
+    {
+        async_unique_resource r( 7, close_now );
+    }
+
+    default_reclaimer().flush();
+
+    EXPECT( trace == "close7" );
+}
+
+CASE( "async_scope_exit: co_await async_execute() runs the exit function in the awaiting coroutine" " [extension]" )
+{
+    trace.clear();
+    manual_executor ex;
+
+    [&]() -> eager_task
+    {
+        async_scope_exit guard( []{ return close_now( 1 ); }, ex );
+
+        co_await guard.async_execute();
+        trace += "-after";
+    }();
+
+    EXPECT( trace == "close1-after" );
+    EXPECT( ex.queue.empty() );
+}
+
+CASE( "async_scope_exit: destruction without async_execute() schedules the exit function" " [extension]" )
+{
+    trace.clear();
+    manual_executor ex;
+
+    // scope:
+    {
+        async_scope_exit guard( []{ return close_now( 1 ); }, ex );
+    }
+
+    ex.run();
+
+    EXPECT( trace == "close1" );
+}
+
+CASE( "async_scope_fail: the exit function is scheduled only when the scope exits via an exception" " [extension]" )
+{
+    trace.clear();
+    manual_executor ex;
+
+    // scope:
+    {
+        async_scope_fail guard( []{ return close_now( 1 ); }, ex );
+    }
+
+    EXPECT( ex.queue.empty() );
+
+    try
+    {
+        async_scope_fail guard( []{ return close_now( 2 ); }, ex );
+        throw std::runtime_error( "fail" );
+    }
+    catch ( ... ) {}
+
+    ex.run();
+
+    EXPECT( trace == "close2" );
+}
+
+CASE( "async_scope_success: the exit function runs only when the scope exits normally" " [extension]" )
+{
+    trace.clear();
+    manual_executor ex;
+
+    try
+    {
+        async_scope_success guard( []{ return close_now( 1 ); }, ex );
+        throw std::runtime_error( "fail" );
+    }
+    catch ( ... ) {}
+
+    EXPECT( ex.queue.empty() );
+
+    [&]() -> eager_task
+    {
+        async_scope_success guard( []{ return close_now( 2 ); }, ex );
+
+        co_await guard.async_execute();
+    }();
+
+    // scope:
+    {
+        async_scope_success guard( []{ return close_now( 3 ); }, ex );
+    }
+
+    ex.run();
+
+    EXPECT( trace == "close2close3" );
+}
+
+#else // scope_HAVE_ASYNC_UNIQUE_RESOURCE
+
+CASE( "async_unique_resource: not available" " [extension]" )
+{
+    EXPECT( !!"async_unique_resource is not available (no C++20 coroutines, or extensions disabled)." );
+}
+
+#endif // scope_HAVE_ASYNC_UNIQUE_RESOURCE
+
+// end of file
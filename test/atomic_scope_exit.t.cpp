@@ -0,0 +1,184 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "scope-main.t.hpp"
+#include "nonstd/scope/atomic_scope_exit.hpp"
+
+#if scope_HAVE_ATOMIC_SCOPE_EXIT
+
+#include <functional>
+#include <memory>
+#include <thread>
+
+using namespace nonstd;
+
+CASE( "atomic_scope_exit: exit function is called at end of scope" " [extension]" )
+{
+    bool is_called = false;
+
+    // scope:
+    {
+        auto guard = make_atomic_scope_exit( [&]{ is_called = true; } );
+    }
+
+    EXPECT( is_called );
+}
+
+CASE( "atomic_scope_exit: exit function is not called at end of scope when released" " [extension]" )
+{
+    bool is_called = false;
+
+    // scope:
+    {
+        auto guard = make_atomic_scope_exit( [&]{ is_called = true; } );
+        guard.release();
+    }
+
+    EXPECT_NOT( is_called );
+}
+
+CASE( "atomic_scope_exit: try_release() reports whether it prevented the exit function" " [extension]" )
+{
+    int count = 0;
+
+    auto guard = make_atomic_scope_exit( [&]{ ++count; } );
+
+    EXPECT(     guard.try_release() );
+    EXPECT_NOT( guard.try_release() );
+    EXPECT_NOT( guard.try_execute() );
+    EXPECT( count == 0 );
+}
+
+CASE( "atomic_scope_exit: try_execute() runs the exit function once" " [extension]" )
+{
+    int count = 0;
+
+    // scope:
+    {
+        auto guard = make_atomic_scope_exit( [&]{ ++count; } );
+
+        EXPECT(     guard.try_execute() );
+        EXPECT_NOT( guard.try_execute() );
+        EXPECT_NOT( guard.try_release() );
+    }
+
+    EXPECT( count == 1 );
+}
+
+CASE( "atomic_scope_exit: exactly one of racing release and execution wins" " [extension][thread]" )
+{
+    enum { N = 2000 };
+
+    int executed = 0;
+    int released = 0;
+
+    for ( int i = 0; i < N; ++i )
+    {
+        std::atomic<int> runs( 0 );
+        std::unique_ptr< atomic_scope_exit<std::function<void()>> > guard(
+            new atomic_scope_exit<std::function<void()>>( [&]{ ++runs; } ) );
+
+        bool won_release = false;
+
+        std::thread completion( [&]{ won_release = guard->try_release(); } );
+
+        bool const won_execute = guard->try_execute();
+
+        completion.join();
+        guard.reset();
+
+        EXPECT( won_release != won_execute );
+        EXPECT( runs == ( won_execute ? 1 : 0 ) );
+
+        executed += won_execute;
+        released += won_release;
+    }
+
+    EXPECT( executed + released == N );
+}
+
+CASE( "atomic_scope_exit: a handle releases the guard, and is harmless after it ran" " [extension]" )
+{
+    int count = 0;
+    atomic_release_handle late;
+
+    // scope:
+    {
+        auto guard = make_atomic_scope_exit( [&]{ ++count; } );
+        atomic_release_handle handle = guard.release_handle();
+
+        EXPECT( handle.try_release() );
+        EXPECT_NOT( guard.try_release() );
+    }
+
+    // scope:
+    {
+        auto guard = make_atomic_scope_exit( [&]{ ++count; } );
+        late = guard.release_handle();
+    }
+
+    EXPECT( count == 1 );
+    EXPECT_NOT( late.try_release() );
+    EXPECT_NOT( atomic_release_handle().try_release() );
+}
+
+CASE( "atomic_scope_exit: a handle moves with the guard" " [extension]" )
+{
+    int count = 0;
+
+    auto a = make_atomic_scope_exit( [&]{ ++count; } );
+    atomic_release_handle handle = a.release_handle();
+    auto b = std::move( a );
+
+    EXPECT( handle.try_release() );
+    EXPECT_NOT( b.try_execute() );
+    EXPECT( count == 0 );
+}
+
+CASE( "atomic_scope_exit: exactly one of a racing release and the destructor wins" " [extension][thread]" )
+{
+    enum { N = 2000 };
+
+    int executed = 0;
+    int released = 0;
+
+    for ( int i = 0; i < N; ++i )
+    {
+        std::atomic<int> runs( 0 );
+        bool won_release = false;
+        std::thread completion;
+
+        // scope:
+        {
+            auto guard = make_atomic_scope_exit( [&]{ ++runs; } );
+            atomic_release_handle handle = guard.release_handle();
+
+            completion = std::thread( [&won_release, handle]() mutable { won_release = handle.try_release(); } );
+        }
+
+        completion.join();
+
+        EXPECT( runs + won_release == 1 );
+
+        executed += runs;
+        released += won_release;
+    }
+
+    EXPECT( executed + released == N );
+}
+
+#else // scope_HAVE_ATOMIC_SCOPE_EXIT
+
+CASE( "atomic_scope_exit: not available" " [extension]" )
+{
+    EXPECT( !!"atomic_scope_exit is not available (no C++11, or extensions disabled)." );
+}
+
+#endif // scope_HAVE_ATOMIC_SCOPE_EXIT
+
+// end of file
@@ -0,0 +1,145 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "scope-main.t.hpp"
+#include "nonstd/scope/atomic_unique_resource.hpp"
+
+#if scope_HAVE_ATOMIC_UNIQUE_RESOURCE
+
+#include <thread>
+#include <vector>
+
+using namespace nonstd;
+
+namespace {
+
+// Handles are indices into a table of states:
+
+enum { N = 1000, alive = 1, dead = 2 };
+
+std::atomic<int> state[ N ];
+
+void kill( int i ) { state[ i ].store( dead ); }
+
+int make( int i ) { state[ i ].store( alive ); return i; }
+
+typedef unique_resource<int, void(*)(int)> handle;
+
+} // anonymous namespace
+
+CASE( "atomic_unique_resource: load() provides the published resource" " [extension]" )
+{
+    atomic_unique_resource<int, void(*)(int)> a( handle( make( 1 ), kill ) );
+
+    auto r = a.load();
+
+    EXPECT( !!r );
+    EXPECT( r.get() == 1 );
+}
+
+CASE( "atomic_unique_resource: load() of a default-constructed object provides no resource" " [extension]" )
+{
+    atomic_unique_resource<int, void(*)(int)> a;
+
+    EXPECT_NOT( !!a.load() );
+}
+
+CASE( "atomic_unique_resource: store() retires the previous resource, which is deleted once unread" " [extension]" )
+{
+    // scope:
+    {
+        atomic_unique_resource<int, void(*)(int)> a( handle( make( 1 ), kill ) );
+
+        // scope:
+        {
+            auto r = a.load();
+
+            a.store( handle( make( 2 ), kill ) );
+            a.reclaim();
+
+            EXPECT( r.get() == 1 );
+            EXPECT( state[ 1 ] == alive );
+            EXPECT( a.load().get() == 2 );
+        }
+
+        a.reclaim();
+
+        EXPECT( state[ 1 ] == dead );
+        EXPECT( state[ 2 ] == alive );
+    }
+
+    EXPECT( state[ 2 ] == dead );
+}
+
+CASE( "atomic_unique_resource: exchange() provides a reader of the previous resource" " [extension]" )
+{
+    atomic_unique_resource<int, void(*)(int)> a( handle( make( 1 ), kill ) );
+
+    // scope:
+    {
+        auto old = a.exchange( handle( make( 2 ), kill ) );
+        a.reclaim();
+
+        EXPECT( old.get() == 1 );
+        EXPECT( state[ 1 ] == alive );
+    }
+
+    a.reclaim();
+
+    EXPECT( state[ 1 ] == dead );
+}
+
+CASE( "atomic_unique_resource: readers never observe a deleted resource" " [extension][thread]" )
+{
+    atomic_unique_resource<int, void(*)(int)> a( handle( make( 0 ), kill ) );
+
+    std::atomic<bool> done( false );
+    std::atomic<int>  failures( 0 );
+
+    std::vector<std::thread> readers;
+
+    for ( int t = 0; t < 4; ++t )
+    {
+        readers.emplace_back( [&]{
+            while ( !done.load() )
+            {
+                auto r = a.load();
+
+                if ( state[ r.get() ].load() != alive )
+                    ++failures;
+            }
+        });
+    }
+
+    for ( int i = 1; i < N; ++i )
+    {
+        a.store( handle( make( i ), kill ) );
+    }
+
+    done = true;
+
+    for ( auto & t : readers )
+        t.join();
+
+    a.reclaim();
+
+    EXPECT( failures == 0 );
+    EXPECT( state[ N - 2 ] == dead );
+    EXPECT( state[ N - 1 ] == alive );
+}
+
+#else // scope_HAVE_ATOMIC_UNIQUE_RESOURCE
+
+CASE( "atomic_unique_resource: not available" " [extension]" )
+{
+    EXPECT( !!"atomic_unique_resource is not available (no C++11, or extensions disabled)." );
+}
+
+#endif // scope_HAVE_ATOMIC_UNIQUE_RESOURCE
+
+// end of file
@@ -0,0 +1,166 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "scope-main.t.hpp"
+#include "nonstd/scope/deferred_release.hpp"
+
+#if scope_HAVE_DEFERRED_RELEASE
+
+#include <memory>
+#include <string>
+
+using namespace nonstd;
+
+namespace {
+
+std::string trace;
+
+void close_handle( int i ) { trace += char( '0' + i ); }
+
+typedef unique_resource<int, deferrable<void(*)(int)>> deferred_handle;
+
+deferred_handle open_handle( int i )
+{
+    return deferred_handle( i, make_deferrable( close_handle ) );
+}
+
+} // anonymous namespace
+
+CASE( "deferred_release_scope: a deferrable deleter runs immediately outside a scope" " [extension]" )
+{
+    trace.clear();
+
+    // scope:
+    {
+        auto h = open_handle( 1 );
+    }
+
+    EXPECT( trace == "1" );
+    EXPECT_NOT( deferred_release_scope::is_active() );
+}
+
+CASE( "deferred_release_scope: deferrable deleters run in order of release at the end of the scope" " [extension]" )
+{
+    trace.clear();
+
+    // scope:
+    {
+        deferred_release_scope batch;
+
+        { auto h = open_handle( 1 ); }
+        { auto h = open_handle( 2 ); }
+        {
+            auto h3 = open_handle( 3 );
+            auto h4 = open_handle( 4 );
+        }
+
+        EXPECT( trace == "" );
+        EXPECT( deferred_release_scope::pending() == 4u );
+    }
+
+    EXPECT( trace == "1243" );
+}
+
+CASE( "deferred_release_scope: the outermost scope runs the batch" " [extension]" )
+{
+    trace.clear();
+
+    // scope:
+    {
+        deferred_release_scope outer;
+        {
+            deferred_release_scope inner;
+            auto h = open_handle( 1 );
+        }
+        EXPECT( trace == "" );
+    }
+
+    EXPECT( trace == "1" );
+}
+
+CASE( "deferred_release_scope: flush() runs the deferred deleters so far" " [extension]" )
+{
+    trace.clear();
+
+    deferred_release_scope batch;
+
+    { auto h = open_handle( 1 ); }
+
+    deferred_release_scope::flush();
+
+    EXPECT( trace == "1" );
+    EXPECT( deferred_release_scope::pending() == 0u );
+}
+
+CASE( "deferred_release_scope: a deferrable scope_exit action is deferred too" " [extension]" )
+{
+    trace.clear();
+
+    // scope:
+    {
+        deferred_release_scope batch;
+        {
+            auto guard = make_scope_exit( make_deferrable( [&]{ trace += "x"; } ) );
+        }
+        EXPECT( trace == "" );
+    }
+
+    EXPECT( trace == "x" );
+}
+
+CASE( "deferred_release_scope: a deferred scope_exit action keeps what it captured by value" " [extension]" )
+{
+    trace.clear();
+    std::weak_ptr<std::string> seen;
+
+    // scope:
+    {
+        deferred_release_scope batch;
+        {
+            auto const text = std::make_shared<std::string>( "inner" );
+            seen = text;
+
+            auto guard = make_scope_exit( make_deferrable( [text]{ trace += *text; } ) );
+        }
+        EXPECT( trace == "" );
+        EXPECT_NOT( seen.expired() );
+    }
+
+    EXPECT( trace == "inner" );
+    EXPECT( seen.expired() );
+}
+
+CASE( "deferred_release_scope: many deferred deleters span several chunks" " [extension]" )
+{
+    trace.clear();
+
+    // scope:
+    {
+        deferred_release_scope batch;
+
+        for ( int i = 0; i < 1000; ++i )
+        {
+            auto h = open_handle( i % 10 );
+        }
+        EXPECT( trace.size() == 0u );
+    }
+
+    EXPECT( trace.size() == 1000u );
+    EXPECT( trace.substr( 0, 10 ) == "0123456789" );
+}
+
+#else // scope_HAVE_DEFERRED_RELEASE
+
+CASE( "deferred_release_scope: not available" " [extension]" )
+{
+    EXPECT( !!"deferred_release_scope is not available (no C++11, or extensions disabled)." );
+}
+
+#endif // scope_HAVE_DEFERRED_RELEASE
+
+// end of file
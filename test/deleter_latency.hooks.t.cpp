@@ -0,0 +1,82 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "scope-main.t.hpp"
+#include "nonstd/scope/deleter_latency.hpp"
+
+// The tweak header of this test program, hooks/deleter_latency/nonstd/scope.tweak.hpp,
+// installs deleter_latency_hooks; see test/CMakeLists.txt:
+
+#if scope_HAVE_DELETER_LATENCY && defined( scope_TEST_DELETER_LATENCY_HOOKS )
+
+#include "resource-types.t.hpp"
+
+#include <string>
+
+using namespace nonstd;
+
+CASE( "deleter_latency_hooks: times each deleter call of a unique_resource" " [extension]" )
+{
+    deleter_latency::set_sampling( 1 );
+
+    // scope:
+    {
+        resource<1> a( 1, noop_deleter<1>() );
+        resource<1> b( 2, noop_deleter<1>() );
+        resource<1> c( 3, noop_deleter<1>() );
+
+        a.reset();
+        c.release();
+    }
+
+    EXPECT( deleter_latency::snapshot< resource<1> >().count() == 2u );
+}
+
+CASE( "deleter_latency_hooks: times 1 in N deleter calls" " [extension]" )
+{
+    deleter_latency::set_sampling( 3 );
+
+    for ( int i = 0; i < 9; ++i )
+        resource<2> r( i, noop_deleter<2>() );
+
+    deleter_latency::set_sampling( 1 );
+
+    EXPECT( deleter_latency::snapshot< resource<2> >().count() == 3u );
+}
+
+CASE( "deleter_latency_hooks: does not time guards" " [extension]" )
+{
+    int calls = 0;
+
+    // scope:
+    {
+        auto on_exit    = make_scope_exit   ( [&]{ ++calls; } );
+        auto on_success = make_scope_success( [&]{ ++calls; } );
+    }
+
+    bool guard_timed = false;
+
+    deleter_latency::for_each( [&]( std::string const & name, latency_histogram const & )
+    {
+        guard_timed = guard_timed || name.find( "scope_" ) != std::string::npos;
+    } );
+
+    EXPECT( calls == 2 );
+    EXPECT_NOT( guard_timed );
+}
+
+#else // scope_HAVE_DELETER_LATENCY
+
+CASE( "deleter_latency_hooks: not available" " [extension]" )
+{
+    EXPECT( !!"deleter_latency_hooks are not installed (no C++11, or extensions disabled)." );
+}
+
+#endif // scope_HAVE_DELETER_LATENCY
+
+// end of file
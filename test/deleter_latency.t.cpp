@@ -0,0 +1,178 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "scope-main.t.hpp"
+#include "nonstd/scope/deleter_latency.hpp"
+
+#if scope_HAVE_DELETER_LATENCY
+
+#include "resource-types.t.hpp"
+
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+using namespace nonstd;
+
+namespace {
+
+// The tests call the hooks directly; deleter_latency.hooks.t.cpp installs them:
+
+template< class D >
+void timed_delete( unique_resource<int, D> & r )
+{
+    auto const start = deleter_latency_hooks::before_delete( r );
+    r.get_deleter()( r.get() );
+    deleter_latency_hooks::after_delete( r, start );
+}
+
+} // anonymous namespace
+
+CASE( "latency_histogram: buckets are log-linear with four buckets per power of two" " [extension]" )
+{
+    EXPECT( latency_histogram::bucket_of( 0 ) == 0u );
+    EXPECT( latency_histogram::bucket_of( 3 ) == 3u );
+    EXPECT( latency_histogram::bucket_of( 4 ) == 4u );
+    EXPECT( latency_histogram::bucket_of( 7 ) == 7u );
+    EXPECT( latency_histogram::bucket_of( 8 ) == 8u );
+    EXPECT( latency_histogram::bucket_of( 9 ) == 8u );
+    EXPECT( latency_histogram::bucket_of( 10 ) == 9u );
+    EXPECT( latency_histogram::bucket_of( ~std::uint64_t( 0 ) ) == latency_histogram::bucket_count - 1u );
+
+    for ( std::size_t i = 0; i < latency_histogram::bucket_count; ++i )
+    {
+        EXPECT( latency_histogram::bucket_of( latency_histogram::lower_bound( i ) ) == i );
+        EXPECT( latency_histogram::bucket_of( latency_histogram::upper_bound( i ) ) == i );
+    }
+}
+
+CASE( "latency_histogram: gives quantiles and merges" " [extension]" )
+{
+    latency_histogram a;
+    latency_histogram b;
+
+    EXPECT( a.quantile( 0.5 ) == 0u );
+
+    for ( int i = 0; i < 90; ++i )
+        a.add( 100 );
+
+    for ( int i = 0; i < 10; ++i )
+        b.add( 10000 );
+
+    a.merge( b );
+
+    EXPECT( a.count() == 100u );
+    EXPECT( a.quantile( 0.5 ) >= 100u );
+    EXPECT( a.quantile( 0.5 ) < 128u );
+    EXPECT( a.quantile( 0.99 ) >= 10000u );
+    EXPECT( a.quantile( 1.0 ) < 12288u );
+}
+
+CASE( "deleter_latency: records the deleter calls of a resource type" " [extension]" )
+{
+    deleter_latency::set_sampling( 1 );
+
+    for ( int i = 0; i < 5; ++i )
+    {
+        resource<1> r( i, noop_deleter<1>() );
+        timed_delete( r );
+        r.release();
+    }
+
+    EXPECT( deleter_latency::snapshot< resource<1> >().count() == 5u );
+    EXPECT( deleter_latency::snapshot< resource<2> >().count() == 0u );
+}
+
+CASE( "deleter_latency: times 1 in N calls" " [extension]" )
+{
+    deleter_latency::set_sampling( 4 );
+
+    for ( int i = 0; i < 12; ++i )
+    {
+        resource<3> r( i, noop_deleter<3>() );
+        timed_delete( r );
+        r.release();
+    }
+
+    deleter_latency::set_sampling( 1 );
+
+    EXPECT( deleter_latency::snapshot< resource<3> >().count() == 3u );
+}
+
+CASE( "deleter_latency: keeps the histograms of threads that exited" " [extension][thread]" )
+{
+    deleter_latency::set_sampling( 1 );
+
+    std::thread t( []
+    {
+        for ( int i = 0; i < 3; ++i )
+            deleter_latency::record< resource<4> >( 1000 );
+    } );
+    t.join();
+
+    deleter_latency::record< resource<4> >( 1000 );
+
+    EXPECT( deleter_latency::snapshot< resource<4> >().count() == 4u );
+}
+
+CASE( "deleter_latency: records the calls of a thread whose histograms are gone" " [extension][thread]" )
+{
+    struct record_on_exit
+    {
+        ~record_on_exit()
+        {
+            deleter_latency::record< resource<6> >( 1000 );
+        }
+    };
+
+    std::thread t( []
+    {
+        // Constructed before the thread's histograms, so destroyed after them:
+
+        static thread_local record_on_exit late;
+        (void) late;
+
+        deleter_latency::record< resource<6> >( 1000 );
+    } );
+    t.join();
+
+    EXPECT( deleter_latency::snapshot< resource<6> >().count() == 2u );
+}
+
+CASE( "deleter_latency: dumps a line per type, with its buckets" " [extension]" )
+{
+    deleter_latency::record< resource<5> >( 100 );
+
+    std::ostringstream os;
+    deleter_latency::dump( os );
+
+    EXPECT( os.str().find( "deleter latency, 1 in 1 calls timed" ) == 0u );
+    EXPECT( os.str().find( "noop_deleter<5>" ) != std::string::npos );
+    EXPECT( os.str().find( "n=1 " ) != std::string::npos );
+}
+
+CASE( "latency_clock: converts ticks to nanoseconds" " [extension]" )
+{
+    std::uint64_t const start = latency_clock::now();
+    std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+    std::uint64_t const ns = latency_clock::to_nanoseconds( latency_clock::now() - start );
+
+    EXPECT( ns >=   9000000u );
+    EXPECT( ns <= 500000000u );
+}
+
+#else // scope_HAVE_DELETER_LATENCY
+
+CASE( "deleter_latency: not available" " [extension]" )
+{
+    EXPECT( !!"deleter_latency is not available (no C++11, or extensions disabled)." );
+}
+
+#endif // scope_HAVE_DELETER_LATENCY
+
+// end of file
@@ -0,0 +1,199 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "scope-main.t.hpp"
+#include "nonstd/scope/ebr_domain.hpp"
+
+#if scope_HAVE_EBR_DOMAIN
+
+#include <thread>
+#include <vector>
+
+using namespace nonstd;
+
+namespace {
+
+std::atomic<int> deleted( 0 );
+
+void count_delete( int ) { ++deleted; }
+
+typedef unique_resource<int, void(*)(int)> handle;
+
+} // anonymous namespace
+
+CASE( "ebr_domain: a retired resource is deleted once the epoch advanced twice" " [extension]" )
+{
+    deleted = 0;
+
+    ebr_domain domain;
+
+    domain.retire( handle( 1, count_delete ) );
+
+    EXPECT( deleted == 0 );
+
+    domain.reclaim();
+    domain.reclaim();
+
+    EXPECT( deleted == 1 );
+}
+
+CASE( "ebr_domain: a pinned scope_epoch defers deletion of a resource retired within it" " [extension]" )
+{
+    deleted = 0;
+
+    ebr_domain domain;
+
+    // scope:
+    {
+        scope_epoch guard( domain );
+
+        domain.retire( handle( 1, count_delete ) );
+
+        domain.reclaim();
+        domain.reclaim();
+        domain.reclaim();
+
+        EXPECT( deleted == 0 );
+    }
+
+    domain.reclaim();
+    domain.reclaim();
+
+    EXPECT( deleted == 1 );
+}
+
+CASE( "ebr_domain: a nested scope_epoch reuses the pin of the enclosing one" " [extension]" )
+{
+    ebr_domain domain( 1 );
+
+    scope_epoch outer( domain );
+    scope_epoch inner( domain );    // would wait forever for the only slot otherwise
+
+    EXPECT( domain.epoch() == 0u );
+}
+
+CASE( "ebr_domain: pending resources are deleted when the domain is destroyed" " [extension]" )
+{
+    deleted = 0;
+
+    // scope:
+    {
+        ebr_domain domain;
+
+        domain.retire( handle( 1, count_delete ) );
+        domain.retire( handle( 2, count_delete ) );
+    }
+
+    EXPECT( deleted == 2 );
+}
+
+CASE( "ebr_domain: retired resources are reclaimed batch-wise" " [extension]" )
+{
+    deleted = 0;
+
+    ebr_domain domain( 4, 8 );
+
+    for ( int i = 0; i < 100; ++i )
+        domain.retire( handle( i, count_delete ) );
+
+    EXPECT( deleted > 0 );
+    EXPECT( deleted < 100 );
+}
+
+CASE( "ebr_domain: more threads than slots can pin and retire at once" " [extension][thread]" )
+{
+    deleted = 0;
+
+    // scope:
+    {
+        ebr_domain domain( 2 );
+
+        std::atomic<int> pinned( 0 );
+        std::vector<std::thread> threads;
+
+        for ( int t = 0; t < 8; ++t )
+        {
+            threads.emplace_back( [&, t]{
+                scope_epoch guard( domain );
+
+                // Wait until all threads are pinned, which needs more slots than there are initially:
+
+                ++pinned;
+
+                while ( pinned < 8 )
+                    std::this_thread::yield();
+
+                domain.retire( handle( t, count_delete ) );
+            });
+        }
+
+        for ( auto & t : threads )
+            t.join();
+
+        EXPECT( pinned == 8 );
+    }
+
+    EXPECT( deleted == 8 );
+}
+
+CASE( "ebr_domain: readers never observe a deleted resource" " [extension][thread]" )
+{
+    enum { N = 10000, alive = 1, dead = 2 };
+
+    static std::atomic<int> state[ N ];
+
+    struct on { static void kill( int i ) { state[ i ] = dead; } };
+
+    ebr_domain domain;
+
+    std::atomic<int> current( 0 );
+    std::atomic<bool> done( false );
+    std::atomic<int> failures( 0 );
+
+    state[ 0 ] = alive;
+
+    std::vector<std::thread> readers;
+
+    for ( int t = 0; t < 4; ++t )
+    {
+        readers.emplace_back( [&]{
+            while ( !done )
+            {
+                scope_epoch guard( domain );
+
+                if ( state[ current.load() ] != alive )
+                    ++failures;
+            }
+        });
+    }
+
+    for ( int i = 1; i < N; ++i )
+    {
+        state[ i ] = alive;
+        int const old = current.exchange( i );
+        domain.retire( handle( old, on::kill ) );
+    }
+
+    done = true;
+
+    for ( auto & t : readers )
+        t.join();
+
+    EXPECT( failures == 0 );
+}
+
+#else // scope_HAVE_EBR_DOMAIN
+
+CASE( "ebr_domain: not available" " [extension]" )
+{
+    EXPECT( !!"ebr_domain is not available (no C++11, or extensions disabled)." );
+}
+
+#endif // scope_HAVE_EBR_DOMAIN
+
+// end of file
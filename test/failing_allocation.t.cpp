@@ -0,0 +1,182 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "scope-main.t.hpp"
+#include "nonstd/scope/shared_resource.hpp"
+#include "nonstd/scope/async_unique_resource.hpp"
+
+// This test program replaces operator new by one that fails on request; as that
+// applies to the whole program, these tests are a program of their own; see test/CMakeLists.txt.
+
+#if scope_CPP11_OR_GREATER
+
+#include <cstdlib>
+#include <new>
+
+// GCC takes the free() in an inlined replacement operator delete for a mismatch:
+
+#if defined( __GNUC__ ) && !defined( __clang__ ) && __GNUC__ >= 11
+# pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+namespace {
+
+// Make the next allocation of this thread fail, see operator new below:
+
+thread_local bool fail_next_allocation = false;
+
+} // anonymous namespace
+
+void * operator new( std::size_t size )
+{
+    if ( fail_next_allocation )
+    {
+        fail_next_allocation = false;
+        throw std::bad_alloc();
+    }
+
+    if ( void * p = std::malloc( size ? size : 1 ) )
+        return p;
+
+    throw std::bad_alloc();
+}
+
+void * operator new( std::size_t size, std::nothrow_t const & ) noexcept
+{
+    try
+    {
+        return ::operator new( size );
+    }
+    catch ( std::bad_alloc const & )
+    {
+        return nullptr;
+    }
+}
+
+void operator delete( void * p ) noexcept
+{
+    std::free( p );
+}
+
+void operator delete( void * p, std::nothrow_t const & ) noexcept
+{
+    std::free( p );
+}
+
+void operator delete( void * p, std::size_t ) noexcept
+{
+    std::free( p );
+}
+
+#endif // scope_CPP11_OR_GREATER
+
+#if scope_HAVE_SHARED_RESOURCE
+
+using namespace nonstd;
+
+namespace {
+
+int close_count = 0;
+
+void close_handle( int ) { ++close_count; }
+
+} // anonymous namespace
+
+CASE( "shared_resource: the resource is deleted if the allocation fails" " [extension]" )
+{
+    close_count = 0;
+    fail_next_allocation = true;
+
+    EXPECT_THROWS_AS( (shared_resource<int, void(*)(int)>( 7, close_handle )), std::bad_alloc );
+    EXPECT( close_count == 1 );
+
+    fail_next_allocation = true;
+
+    EXPECT_THROWS_AS( (shared_resource<int, void(*)(int)>( 7, close_handle, false )), std::bad_alloc );
+    EXPECT( close_count == 1 );
+}
+
+#else // scope_HAVE_SHARED_RESOURCE
+
+CASE( "shared_resource: not available" " [extension]" )
+{
+    EXPECT( !!"shared_resource is not available (no C++11, or extensions disabled)." );
+}
+
+#endif // scope_HAVE_SHARED_RESOURCE
+
+#if scope_HAVE_ASYNC_UNIQUE_RESOURCE
+
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace nonstd;
+
+namespace {
+
+std::string trace;
+
+struct manual_executor
+{
+    void submit( std::function<void()> fn )
+    {
+        queue.push_back( std::move( fn ) );
+    }
+
+    std::vector< std::function<void()> > queue;
+};
+
+async_task close_now( int i )
+{
+    trace += "close" + std::to_string( i );
+    co_return;
+}
+
+} // anonymous namespace
+
+CASE( "async_unique_resource: without memory for the coroutine, destruction runs the deleter on this thread" " [extension]" )
+{
+    trace.clear();
+    manual_executor ex;
+
+    // scope:
+    {
+        async_unique_resource r( 7, close_now, ex );
+        fail_next_allocation = true;
+    }
+
+    EXPECT( ex.queue.empty() );
+    EXPECT( trace == "close7" );
+}
+
+CASE( "async_scope_exit: without memory for the coroutine, destruction runs the exit function on this thread" " [extension]" )
+{
+    trace.clear();
+    manual_executor ex;
+
+    // scope:
+    {
+        async_scope_exit guard( []{ return close_now( 1 ); }, ex );
+        fail_next_allocation = true;
+    }
+
+    EXPECT( ex.queue.empty() );
+    EXPECT( trace == "close1" );
+}
+
+#else // scope_HAVE_ASYNC_UNIQUE_RESOURCE
+
+CASE( "async_unique_resource: not available" " [extension]" )
+{
+    EXPECT( !!"async_unique_resource is not available (no C++20 coroutines, or extensions disabled)." );
+}
+
+#endif // scope_HAVE_ASYNC_UNIQUE_RESOURCE
+
+// end of file
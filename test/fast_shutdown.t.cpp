@@ -0,0 +1,91 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "scope-main.t.hpp"
+#include "nonstd/scope/fast_shutdown.hpp"
+
+#if scope_HAVE_FAST_SHUTDOWN
+
+#include <string>
+
+using namespace nonstd;
+
+namespace {
+
+std::string trace;
+
+void close_handle( int i ) { trace += "close" + std::to_string( i ); }
+void fsync_handle( int i ) { trace += "fsync" + std::to_string( i ); }
+
+// Tests leave fast-shutdown mode again, so later tests are not affected:
+
+struct fast_shutdown_for_test
+{
+    fast_shutdown_for_test()  { fast_shutdown(); }
+    ~fast_shutdown_for_test() { scope::detail::fast_shutdown_state() = false; }
+};
+
+} // anonymous namespace
+
+CASE( "reclaimable_deleter: calls the deleter in normal operation" " [extension]" )
+{
+    trace.clear();
+
+    // scope:
+    {
+        auto r = make_reclaimable_resource_checked( 7, -1, close_handle );
+    }
+
+    EXPECT_NOT( is_fast_shutdown() );
+    EXPECT( trace == "close7" );
+}
+
+CASE( "reclaimable_deleter: does nothing after fast_shutdown(), essential deleters still run" " [extension]" )
+{
+    trace.clear();
+
+    auto reclaimable = make_reclaimable_resource_checked( 7, -1, close_handle );
+    auto essential   = make_unique_resource_checked( 8, -1, fsync_handle );
+
+    std::uint64_t const skipped = fast_shutdown_skipped();
+
+    fast_shutdown_for_test shutdown;
+
+    EXPECT( is_fast_shutdown() );
+
+    reclaimable.reset();
+    essential.reset();
+
+    EXPECT( trace == "fsync8" );
+    EXPECT( fast_shutdown_skipped() == skipped + 1 );
+}
+
+CASE( "reclaimable_deleter: also wraps a scope_exit exit function" " [extension]" )
+{
+    trace.clear();
+
+    fast_shutdown_for_test shutdown;
+
+    // scope:
+    {
+        auto guard = make_scope_exit( make_reclaimable_deleter( []{ trace += "free"; } ) );
+    }
+
+    EXPECT( trace == "" );
+}
+
+#else // scope_HAVE_FAST_SHUTDOWN
+
+CASE( "fast_shutdown: not available" " [extension]" )
+{
+    EXPECT( !!"fast_shutdown is not available (no C++11, or extensions disabled)." );
+}
+
+#endif // scope_HAVE_FAST_SHUTDOWN
+
+// end of file
@@ -0,0 +1,71 @@
+# Copyright 2020 by Martin Moene
+#
+# https://github.com/martinmoene/scope-lite
+#
+# Distributed under the Boost Software License, Version 1.0.
+# (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+# Check that the default hook policy compiles away: compile SOURCE with -O2 and require
+# that each use_<name>() function has the same code size as its hand-written equivalent
+# hand_<name>(). To show that the check can see hooks, also compile SOURCE with a policy
+# that counts events, and require that the size of each use_<name>() then differs.
+#
+# Usage: cmake -DCXX=<compiler> -DNM=<nm> -DINCLUDE=<dir> -DSOURCE=<file> -DBINARY=<dir> -P hooks.codegen.cmake
+
+set( names scope_exit scope_fail scope_success released_guard unique_resource )
+
+# size of function <function>() in the symbols listed by nm -S -C:
+
+function( function_size symbols function result )
+    string( REGEX MATCH "[0-9a-fA-F]+ [Tt] ${function}\\(\\)" line "${symbols}" )
+
+    if( NOT line )
+        message( FATAL_ERROR "hooks codegen: no function '${function}()' in:\n${symbols}" )
+    endif()
+
+    string( REGEX REPLACE " .*" "" size "${line}" )
+    set( ${result} ${size} PARENT_SCOPE )
+endfunction()
+
+foreach( policy default probe )
+    set( object "${BINARY}/hooks.codegen-${policy}.o" )
+    set( define "" )
+
+    if( policy STREQUAL "probe" )
+        set( define -Dscope_CODEGEN_PROBE_HOOKS )
+    endif()
+
+    execute_process(
+        COMMAND "${CXX}" -std=c++11 -O2 ${define} -I "${INCLUDE}" -c "${SOURCE}" -o "${object}"
+        RESULT_VARIABLE result )
+
+    if( NOT result EQUAL 0 )
+        message( FATAL_ERROR "hooks codegen: cannot compile '${SOURCE}' with the ${policy} hooks" )
+    endif()
+
+    execute_process(
+        COMMAND "${NM}" -S -C "${object}"
+        OUTPUT_VARIABLE symbols
+        RESULT_VARIABLE result )
+
+    if( NOT result EQUAL 0 )
+        message( FATAL_ERROR "hooks codegen: cannot list the symbols of '${object}'" )
+    endif()
+
+    foreach( name ${names} )
+        function_size( "${symbols}" use_${name}  use_size  )
+        function_size( "${symbols}" hand_${name} hand_size )
+
+        if( policy STREQUAL "default" AND NOT use_size STREQUAL hand_size )
+            message( FATAL_ERROR "hooks codegen: with -O2, use_${name}() takes 0x${use_size} bytes, "
+                "its hand-written equivalent 0x${hand_size}; the default hooks did not compile away" )
+        elseif( policy STREQUAL "probe" AND use_size STREQUAL hand_size )
+            message( FATAL_ERROR "hooks codegen: with the probe hooks, use_${name}() takes as many bytes "
+                "as its hand-written equivalent; the check is ineffective" )
+        endif()
+    endforeach()
+endforeach()
+
+message( STATUS "hooks codegen: with -O2, the default hooks add no code" )
+
+# end of file
@@ -0,0 +1,119 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Compiled by hooks.codegen.cmake, without the test tweak header: with optimization, each
+// use_*() function must compile to the same code as its hand-written equivalent hand_*(),
+// a plain flag and a direct call of the release function. With scope_CODEGEN_PROBE_HOOKS,
+// a policy that counts events is installed, which the comparison must detect.
+
+#if defined( scope_CODEGEN_PROBE_HOOKS )
+
+extern int probe_events;
+
+struct probe_hooks
+{
+    typedef int token;
+
+    template< class T > static void on_construct( T const & ) noexcept { ++probe_events; }
+    template< class T > static void on_release  ( T const & ) noexcept { ++probe_events; }
+    template< class T > static token before_exit  ( T const & ) noexcept { return ++probe_events; }
+    template< class T > static void  after_exit   ( T const &, token ) noexcept { ++probe_events; }
+    template< class T > static token before_delete( T const & ) noexcept { return ++probe_events; }
+    template< class T > static void  after_delete ( T const &, token ) noexcept { ++probe_events; }
+};
+
+# define scope_CONFIG_HOOKS  ::probe_hooks
+#endif
+
+#include "nonstd/scope.hpp"
+
+void acquire( int ) noexcept;
+void release( int ) noexcept;
+void work() noexcept;
+
+void use_scope_exit()
+{
+    auto guard = nonstd::make_scope_exit( []{ release( 1 ); } );
+    work();
+}
+
+void hand_scope_exit()
+{
+    bool const execute = true;
+    work();
+
+    if ( execute )
+        release( 1 );
+}
+
+void use_scope_fail()
+{
+    auto guard = nonstd::make_scope_fail( []{ release( 4 ); } );
+    work();
+}
+
+void hand_scope_fail()
+{
+    int const uncaught = nonstd::scope::detail::uncaught_exceptions();
+    work();
+
+    if ( nonstd::scope::detail::uncaught_exceptions() > uncaught )
+        release( 4 );
+}
+
+void use_scope_success()
+{
+    auto guard = nonstd::make_scope_success( []{ release( 5 ); } );
+    work();
+}
+
+void hand_scope_success()
+{
+    int const uncaught = nonstd::scope::detail::uncaught_exceptions();
+    work();
+
+    if ( nonstd::scope::detail::uncaught_exceptions() <= uncaught )
+        release( 5 );
+}
+
+void use_released_guard()
+{
+    auto guard = nonstd::make_scope_exit( []{ release( 2 ); } );
+    work();
+    guard.release();
+}
+
+void hand_released_guard()
+{
+    bool execute = true;
+    work();
+    execute = false;
+
+    if ( execute )
+        release( 2 );
+}
+
+void use_unique_resource()
+{
+    auto resource = nonstd::make_unique_resource_checked( 3, -1, []( int x ){ release( x ); } );
+    acquire( resource.get() );
+    work();
+}
+
+void hand_unique_resource()
+{
+    int const resource = 3;
+    bool const execute = resource != -1;
+    acquire( resource );
+    work();
+
+    if ( execute )
+        release( resource );
+}
+
+// end of file
@@ -0,0 +1,236 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "scope-main.t.hpp"
+
+// The tweak header of this test program, hooks/counting/nonstd/scope.tweak.hpp,
+// installs test_hooks::counting_hooks; see test/CMakeLists.txt:
+
+#if scope_HAVE_HOOKS && defined( scope_TEST_HOOKS )
+
+#include <stdexcept>
+#include <string>
+
+using namespace nonstd;
+
+namespace {
+
+// The events counted by the hooks since construction:
+
+struct events
+{
+    test_hooks::counts start;
+
+    events()
+        : start( test_hooks::thread_counts() )
+    {}
+
+    int constructed() const { return test_hooks::thread_counts().constructed - start.constructed; }
+    int released()    const { return test_hooks::thread_counts().released    - start.released;    }
+    int exiting()     const { return test_hooks::thread_counts().exiting     - start.exiting;     }
+    int exited()      const { return test_hooks::thread_counts().exited      - start.exited;      }
+    int deleting()    const { return test_hooks::thread_counts().deleting    - start.deleting;    }
+    int deleted()     const { return test_hooks::thread_counts().deleted     - start.deleted;     }
+    int unpaired()    const { return test_hooks::thread_counts().unpaired    - start.unpaired;    }
+};
+
+struct close_counter
+{
+    int * closed;
+
+    void operator()( int ) const
+    {
+        ++*closed;
+    }
+};
+
+// Appends the events to a trace, and passes its name as token:
+
+std::string & hook_trace()
+{
+    static std::string trace;
+    return trace;
+}
+
+template< char Name >
+struct trace_hooks
+{
+    template< class T > static void on_construct( T const & ) noexcept { hook_trace() += Name; }
+    template< class T > static void on_release( T const & ) noexcept { hook_trace() += Name; }
+
+    template< class T > static char before_exit( T const & ) noexcept { hook_trace() += '('; hook_trace() += Name; return Name; }
+    template< class T > static void after_exit( T const &, char token ) noexcept { hook_trace() += token; hook_trace() += ')'; }
+
+    template< class T > static char before_delete( T const & ) noexcept { hook_trace() += '['; hook_trace() += Name; return Name; }
+    template< class T > static void after_delete( T const &, char token ) noexcept { hook_trace() += token; hook_trace() += ']'; }
+};
+
+} // anonymous namespace
+
+CASE( "hooks: scope_exit reports construction and the exit function's call" " [extension]" )
+{
+    events ev;
+    bool called = false;
+    int exiting_in_exit_function = -1;
+
+    // scope:
+    {
+        auto guard = make_scope_exit( [&]{ called = true; exiting_in_exit_function = ev.exiting(); } );
+
+        EXPECT( ev.constructed() == 1 );
+        EXPECT( ev.exiting() == 0 );
+    }
+
+    EXPECT( called );
+    EXPECT( exiting_in_exit_function == 1 );
+    EXPECT( ev.exited() == 1 );
+    EXPECT( ev.unpaired() == 0 );
+}
+
+CASE( "hooks: a released guard reports the release and no exit" " [extension]" )
+{
+    events ev;
+
+    // scope:
+    {
+        auto guard = make_scope_exit( []{} );
+        guard.release();
+    }
+
+    EXPECT( ev.constructed() == 1 );
+    EXPECT( ev.released() == 1 );
+    EXPECT( ev.exiting() == 0 );
+    EXPECT( ev.exited() == 0 );
+}
+
+CASE( "hooks: moving a guard is not an event" " [extension]" )
+{
+    events ev;
+
+    // scope:
+    {
+        auto a = make_scope_exit( []{} );
+        auto b = std::move( a );
+    }
+
+    EXPECT( ev.constructed() == 1 );
+    EXPECT( ev.released() == 0 );
+    EXPECT( ev.exited() == 1 );
+}
+
+CASE( "hooks: scope_fail and scope_success report an exit only on their outcome" " [extension]" )
+{
+    events ev;
+
+    try
+    {
+        auto on_fail    = make_scope_fail   ( []{} );
+        auto on_success = make_scope_success( []{} );
+
+        throw std::runtime_error( "fail" );
+    }
+    catch ( std::exception const & ) {}
+
+    EXPECT( ev.constructed() == 2 );
+    EXPECT( ev.exiting() == 1 );
+    EXPECT( ev.exited() == 1 );
+
+    // scope:
+    {
+        auto on_fail    = make_scope_fail   ( []{} );
+        auto on_success = make_scope_success( []{} );
+    }
+
+    EXPECT( ev.constructed() == 4 );
+    EXPECT( ev.exited() == 2 );
+    EXPECT( ev.unpaired() == 0 );
+}
+
+CASE( "hooks: unique_resource reports taking ownership and the deleter's call" " [extension]" )
+{
+    events ev;
+    int closed = 0;
+
+    // scope:
+    {
+        auto r = make_unique_resource_checked( 7, -1, close_counter{ &closed } );
+
+        EXPECT( ev.constructed() == 1 );
+
+        r.reset( 8 );
+
+        EXPECT( closed == 1 );
+        EXPECT( ev.deleted() == 1 );
+        EXPECT( ev.constructed() == 2 );
+    }
+
+    EXPECT( closed == 2 );
+    EXPECT( ev.deleting() == 2 );
+    EXPECT( ev.deleted() == 2 );
+    EXPECT( ev.unpaired() == 0 );
+}
+
+CASE( "hooks: a unique_resource that owns nothing reports no events" " [extension]" )
+{
+    events ev;
+    int closed = 0;
+
+    // scope:
+    {
+        auto r = make_unique_resource_checked( -1, -1, close_counter{ &closed } );
+        auto s = std::move( r );
+    }
+
+    EXPECT( closed == 0 );
+    EXPECT( ev.constructed() == 0 );
+    EXPECT( ev.deleting() == 0 );
+}
+
+CASE( "hooks: a released unique_resource reports the release and no delete" " [extension]" )
+{
+    events ev;
+    int closed = 0;
+
+    // scope:
+    {
+        unique_resource<int, close_counter> r( 7, close_counter{ &closed } );
+        r.release();
+        r.release();
+    }
+
+    EXPECT( closed == 0 );
+    EXPECT( ev.constructed() == 1 );
+    EXPECT( ev.released() == 1 );
+    EXPECT( ev.deleting() == 0 );
+}
+
+CASE( "hooks: compose_hooks passes each event to both policies, the second within the first" " [extension]" )
+{
+    typedef scope::compose_hooks< trace_hooks<'a'>, trace_hooks<'b'> > both;
+
+    int const x = 0;
+    hook_trace().clear();
+
+    both::on_construct( x );
+    both::on_release( x );
+    both::after_exit( x, both::before_exit( x ) );
+    both::after_delete( x, both::before_delete( x ) );
+
+    EXPECT( hook_trace() == "abab(a(bb)a)[a[bb]a]" );
+}
+
+#else // scope_HAVE_HOOKS
+
+CASE( "hooks: not available" " [extension]" )
+{
+    EXPECT( !!"hooks are not available (no C++11, or std::scope is used)." );
+}
+
+#endif // scope_HAVE_HOOKS
+
+// end of file
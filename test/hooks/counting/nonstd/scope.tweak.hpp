@@ -0,0 +1,94 @@
+// The tweak header of the hooks test program: count the events of scope guards
+// and unique_resource, see hooks.t.cpp:
+
+#if __cplusplus >= 201103L
+
+#define scope_TEST_HOOKS  1
+#define scope_CONFIG_HOOKS  ::test_hooks::counting_hooks
+
+#if __cplusplus >= 202002L
+# include <type_traits>
+# define scope_TEST_HOOK_CONSTEXPR  constexpr
+# define scope_TEST_HOOK_IS_CONSTANT_EVALUATED()  std::is_constant_evaluated()
+#else
+# define scope_TEST_HOOK_CONSTEXPR  /*constexpr*/
+# define scope_TEST_HOOK_IS_CONSTANT_EVALUATED()  false
+#endif
+
+namespace test_hooks {
+
+struct counts
+{
+    int constructed;
+    int released;
+    int exiting;
+    int exited;
+    int deleting;
+    int deleted;
+    int unpaired;
+};
+
+inline counts & thread_counts()
+{
+    static thread_local counts c = {};
+    return c;
+}
+
+// The token of before_*() is the address of the guard or unique_resource:
+
+struct counting_hooks
+{
+    template< class T >
+    static scope_TEST_HOOK_CONSTEXPR void on_construct( T const & ) noexcept
+    {
+        if ( !scope_TEST_HOOK_IS_CONSTANT_EVALUATED() )
+            ++thread_counts().constructed;
+    }
+
+    template< class T >
+    static scope_TEST_HOOK_CONSTEXPR void on_release( T const & ) noexcept
+    {
+        if ( !scope_TEST_HOOK_IS_CONSTANT_EVALUATED() )
+            ++thread_counts().released;
+    }
+
+    template< class T >
+    static scope_TEST_HOOK_CONSTEXPR void const * before_exit( T const & x ) noexcept
+    {
+        if ( !scope_TEST_HOOK_IS_CONSTANT_EVALUATED() )
+            ++thread_counts().exiting;
+        return &x;
+    }
+
+    template< class T >
+    static scope_TEST_HOOK_CONSTEXPR void after_exit( T const & x, void const * token ) noexcept
+    {
+        if ( !scope_TEST_HOOK_IS_CONSTANT_EVALUATED() )
+        {
+            ++thread_counts().exited;
+            thread_counts().unpaired += token != &x;
+        }
+    }
+
+    template< class T >
+    static scope_TEST_HOOK_CONSTEXPR void const * before_delete( T const & x ) noexcept
+    {
+        if ( !scope_TEST_HOOK_IS_CONSTANT_EVALUATED() )
+            ++thread_counts().deleting;
+        return &x;
+    }
+
+    template< class T >
+    static scope_TEST_HOOK_CONSTEXPR void after_delete( T const & x, void const * token ) noexcept
+    {
+        if ( !scope_TEST_HOOK_IS_CONSTANT_EVALUATED() )
+        {
+            ++thread_counts().deleted;
+            thread_counts().unpaired += token != &x;
+        }
+    }
+};
+
+} // namespace test_hooks
+
+#endif // __cplusplus >= 201103L
@@ -0,0 +1,10 @@
+// The tweak header of the deleter_latency_hooks test program, see deleter_latency.hooks.t.cpp:
+
+#if __cplusplus >= 201103L
+
+#define scope_TEST_DELETER_LATENCY_HOOKS  1
+
+namespace nonstd { namespace scope { struct deleter_latency_hooks; } }
+#define scope_CONFIG_HOOKS  ::nonstd::scope::deleter_latency_hooks
+
+#endif // __cplusplus >= 201103L
@@ -0,0 +1,10 @@
+// The tweak header of the resource_tracking_hooks test program, see resource_tracking.hooks.t.cpp:
+
+#if __cplusplus >= 201103L
+
+#define scope_TEST_RESOURCE_TRACKING_HOOKS  1
+
+namespace nonstd { namespace scope { struct resource_tracking_hooks; } }
+#define scope_CONFIG_HOOKS  ::nonstd::scope::resource_tracking_hooks
+
+#endif // __cplusplus >= 201103L
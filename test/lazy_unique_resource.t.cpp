@@ -0,0 +1,166 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "scope-main.t.hpp"
+#include "nonstd/scope/lazy_unique_resource.hpp"
+
+#if scope_HAVE_LAZY_UNIQUE_RESOURCE
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+using namespace nonstd;
+
+namespace {
+
+std::atomic<int> opened( 0 );
+std::atomic<int> closed( 0 );
+
+struct open_handle
+{
+    int operator()() const
+    {
+        ++opened;
+        return value;
+    }
+
+    int value;
+};
+
+struct close_handle
+{
+    void operator()( int ) const
+    {
+        ++closed;
+    }
+};
+
+typedef lazy_unique_resource<int, close_handle, open_handle> lazy_handle;
+
+void reset_counts()
+{
+    opened = 0;
+    closed = 0;
+}
+
+} // anonymous namespace
+
+CASE( "lazy_unique_resource: acquires on first get(), once" " [extension]" )
+{
+    reset_counts();
+
+    // scope:
+    {
+        lazy_handle h( open_handle{ 7 }, -1, close_handle() );
+
+        EXPECT( opened == 0 );
+        EXPECT_NOT( h.is_initialized() );
+
+        EXPECT( h.get() == 7 );
+        EXPECT( h.get() == 7 );
+        EXPECT( opened == 1 );
+        EXPECT( h.is_acquired() );
+    }
+
+    EXPECT( closed == 1 );
+}
+
+CASE( "lazy_unique_resource: a resource that is never used is neither acquired nor deleted" " [extension]" )
+{
+    reset_counts();
+
+    // scope:
+    {
+        lazy_handle h( open_handle{ 7 }, -1, close_handle() );
+    }
+
+    EXPECT( opened == 0 );
+    EXPECT( closed == 0 );
+}
+
+CASE( "lazy_unique_resource: an invalid resource is not deleted" " [extension]" )
+{
+    reset_counts();
+
+    // scope:
+    {
+        lazy_handle h( open_handle{ -1 }, -1, close_handle() );
+
+        EXPECT( h.get() == -1 );
+        EXPECT( h.is_initialized() );
+        EXPECT_NOT( h.is_acquired() );
+    }
+
+    EXPECT( closed == 0 );
+}
+
+CASE( "lazy_unique_resource: a throwing factory is tried again at the next get()" " [extension]" )
+{
+    int attempts = 0;
+
+    auto factory = [&]() -> int
+    {
+        if ( ++attempts == 1 )
+            throw std::runtime_error( "not yet" );
+        return 7;
+    };
+
+    lazy_unique_resource<int, close_handle, decltype( factory )> h( factory, -1, close_handle() );
+
+    EXPECT_THROWS_AS( h.get(), std::runtime_error );
+    EXPECT_NOT( h.is_initialized() );
+    EXPECT( h.get() == 7 );
+    EXPECT( attempts == 2 );
+}
+
+CASE( "lazy_unique_resource: concurrent first use acquires once" " [extension][thread]" )
+{
+    reset_counts();
+
+    // scope:
+    {
+        lazy_handle h( open_handle{ 7 }, -1, close_handle() );
+        std::atomic<int> sum( 0 );
+
+        std::thread users[4];
+
+        for ( auto & u : users )
+            u = std::thread( [&]{ sum += h.get(); } );
+
+        for ( auto & u : users )
+            u.join();
+
+        EXPECT( sum == 28 );
+        EXPECT( opened == 1 );
+    }
+
+    EXPECT( closed == 1 );
+}
+
+#if scope_CPP17_OR_GREATER
+
+CASE( "lazy_unique_resource: deduces its types from the constructor arguments (C++17)" " [extension]" )
+{
+    lazy_unique_resource h( []{ return 7; }, -1, []( int ){} );
+
+    EXPECT( h.get() == 7 );
+}
+
+#endif // scope_CPP17_OR_GREATER
+
+#else // scope_HAVE_LAZY_UNIQUE_RESOURCE
+
+CASE( "lazy_unique_resource: not available" " [extension]" )
+{
+    EXPECT( !!"lazy_unique_resource is not available (no C++11, or extensions disabled)." );
+}
+
+#endif // scope_HAVE_LAZY_UNIQUE_RESOURCE
+
+// end of file
@@ -0,0 +1,155 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "scope-main.t.hpp"
+#include "nonstd/scope/owner_affine.hpp"
+
+#if scope_HAVE_OWNER_AFFINE
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+using namespace nonstd;
+
+namespace {
+
+std::atomic<int> released( 0 );
+std::thread::id released_on;
+
+struct release_chunk
+{
+    void operator()( int ) const
+    {
+        released_on = std::this_thread::get_id();
+        ++released;
+    }
+};
+
+typedef unique_resource<int, owner_affine_deleter<release_chunk>> affine_chunk;
+
+affine_chunk acquire_chunk( int i )
+{
+    return make_owner_affine_resource_checked( i, -1, release_chunk() );
+}
+
+} // anonymous namespace
+
+CASE( "owner_affine_deleter: same-thread destruction calls the deleter directly" " [extension]" )
+{
+    released = 0;
+
+    // scope:
+    {
+        auto c = acquire_chunk( 7 );
+        EXPECT( c.get_deleter().is_owner_thread() );
+    }
+
+    EXPECT( released == 1 );
+    EXPECT( released_on == std::this_thread::get_id() );
+}
+
+CASE( "owner_affine_deleter: cross-thread destruction defers the release to the owner's next drain" " [extension][thread]" )
+{
+    released = 0;
+
+    auto c = acquire_chunk( 7 );
+
+    std::thread( [&]{
+        EXPECT_NOT( c.get_deleter().is_owner_thread() );
+        c.reset();
+    }).join();
+
+    EXPECT( released == 0 );
+    EXPECT( drain_owner_inbox() == 1u );
+    EXPECT( released == 1 );
+    EXPECT( released_on == std::this_thread::get_id() );
+}
+
+CASE( "owner_affine_deleter: the owner drains its inbox at its next acquire" " [extension][thread]" )
+{
+    released = 0;
+
+    auto c = acquire_chunk( 7 );
+
+    std::thread( [&]{ c.reset(); } ).join();
+
+    auto d = acquire_chunk( 8 );
+
+    EXPECT( released == 1 );
+    EXPECT( released_on == std::this_thread::get_id() );
+}
+
+CASE( "owner_affine_deleter: an exiting owner runs the releases in its inbox" " [extension][thread]" )
+{
+    released = 0;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    int step = 0;
+    std::thread::id owner_id;
+    affine_chunk c = acquire_chunk( 0 );
+    c.release();
+
+    std::thread owner( [&]{
+        owner_id = std::this_thread::get_id();
+        c = acquire_chunk( 7 );
+
+        std::unique_lock<std::mutex> lock( mutex );
+        step = 1;
+        cv.notify_one();
+        cv.wait( lock, [&]{ return step == 2; } );
+    });
+
+    // scope:
+    {
+        std::unique_lock<std::mutex> lock( mutex );
+        cv.wait( lock, [&]{ return step == 1; } );
+    }
+
+    c.reset();
+    EXPECT( released == 0 );
+
+    // scope:
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        step = 2;
+        cv.notify_one();
+    }
+
+    owner.join();
+
+    EXPECT( released == 1 );
+    EXPECT( released_on == owner_id );
+}
+
+CASE( "owner_affine_deleter: a release after the owner exited runs on the releasing thread" " [extension][thread]" )
+{
+    released = 0;
+
+    affine_chunk c = acquire_chunk( 0 );
+    c.release();
+
+    std::thread( [&]{ c = acquire_chunk( 7 ); } ).join();
+
+    c.reset();
+
+    EXPECT( released == 1 );
+    EXPECT( released_on == std::this_thread::get_id() );
+}
+
+#else // scope_HAVE_OWNER_AFFINE
+
+CASE( "owner_affine_deleter: not available" " [extension]" )
+{
+    EXPECT( !!"owner_affine_deleter is not available (no C++11, or extensions disabled)." );
+}
+
+#endif // scope_HAVE_OWNER_AFFINE
+
+// end of file
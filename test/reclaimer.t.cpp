@@ -0,0 +1,128 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "scope-main.t.hpp"
+#include "nonstd/scope/reclaimer.hpp"
+
+#if scope_HAVE_RECLAIMER
+
+#include <thread>
+
+using namespace nonstd;
+
+namespace {
+
+std::atomic<int> closed( 0 );
+std::thread::id closed_on;
+
+struct close_handle
+{
+    void operator()( int ) const
+    {
+        closed_on = std::this_thread::get_id();
+        ++closed;
+    }
+};
+
+typedef unique_resource<int, offload_deleter<close_handle>> offloaded_handle;
+
+} // anonymous namespace
+
+CASE( "reclaimer: an offloaded deleter runs on the reclaimer's thread" " [extension][thread]" )
+{
+    closed = 0;
+    reclaimer r;
+
+    // scope:
+    {
+        offloaded_handle h( 7, offload_deleter<close_handle>( close_handle(), r ) );
+    }
+
+    r.flush();
+
+    EXPECT( closed == 1 );
+    EXPECT( closed_on != std::this_thread::get_id() );
+}
+
+CASE( "reclaimer: flush() waits for all actions submitted before it" " [extension][thread]" )
+{
+    std::atomic<int> count( 0 );
+    reclaimer r;
+
+    for ( int i = 0; i < 1000; ++i )
+        r.submit( [&]{ ++count; } );
+
+    r.flush();
+
+    EXPECT( count == 1000 );
+    EXPECT( r.pending() == 0u );
+}
+
+CASE( "reclaimer: a full queue makes the deleter run synchronously" " [extension]" )
+{
+    closed = 0;
+    reclaimer r( 0 );
+
+    // scope:
+    {
+        auto h = make_unique_resource_checked( 7, -1, make_offload_deleter( close_handle(), r ) );
+    }
+
+    EXPECT( closed == 1 );
+    EXPECT( closed_on == std::this_thread::get_id() );
+    EXPECT( r.synchronous_count() == 1u );
+}
+
+CASE( "reclaimer: pending actions run when the reclaimer is destroyed" " [extension][thread]" )
+{
+    std::atomic<int> count( 0 );
+
+    // scope:
+    {
+        reclaimer r;
+
+        for ( int i = 0; i < 1000; ++i )
+            r.submit( [&]{ ++count; } );
+    }
+
+    EXPECT( count == 1000 );
+}
+
+CASE( "reclaimer: many producers can submit concurrently" " [extension][thread]" )
+{
+    std::atomic<int> count( 0 );
+    reclaimer r( 64 );
+
+    std::thread producers[4];
+
+    for ( auto & p : producers )
+    {
+        p = std::thread( [&]{
+            for ( int i = 0; i < 1000; ++i )
+                r.submit( [&]{ ++count; } );
+        });
+    }
+
+    for ( auto & p : producers )
+        p.join();
+
+    r.flush();
+
+    EXPECT( count == 4000 );
+}
+
+#else // scope_HAVE_RECLAIMER
+
+CASE( "reclaimer: not available" " [extension]" )
+{
+    EXPECT( !!"reclaimer is not available (no C++11, or extensions disabled)." );
+}
+
+#endif // scope_HAVE_RECLAIMER
+
+// end of file
@@ -0,0 +1,32 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TEST_SCOPE_LITE_RESOURCE_TYPES_H_INCLUDED
+#define TEST_SCOPE_LITE_RESOURCE_TYPES_H_INCLUDED
+
+#include "nonstd/scope.hpp"
+
+namespace {
+
+// The hook policies keep their statistics per resource type, so each test
+// uses a resource type of its own, resource<N>:
+
+template< int N >
+struct noop_deleter
+{
+    void operator()( int ) const {}
+};
+
+template< int N >
+using resource = nonstd::unique_resource<int, noop_deleter<N>>;
+
+} // anonymous namespace
+
+#endif // TEST_SCOPE_LITE_RESOURCE_TYPES_H_INCLUDED
+
+// end of file
@@ -0,0 +1,142 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "scope-main.t.hpp"
+#include "nonstd/scope/resource_governor.hpp"
+
+#if scope_HAVE_RESOURCE_GOVERNOR
+
+#include <thread>
+
+using namespace nonstd;
+
+namespace {
+
+int closed = 0;
+
+void close_handle( int ) { ++closed; }
+
+} // anonymous namespace
+
+CASE( "resource_governor: try_acquire() fails when the budget is exhausted" " [extension]" )
+{
+    resource_budget budget( 2 );
+
+    auto p1 = budget.try_acquire();
+    auto p2 = budget.try_acquire();
+    auto p3 = budget.try_acquire();
+
+    EXPECT(     !!p1 );
+    EXPECT(     !!p2 );
+    EXPECT_NOT( !!p3 );
+    EXPECT( budget.live() == 2u );
+}
+
+CASE( "resource_governor: an unused permit is refunded" " [extension]" )
+{
+    resource_budget budget( 1 );
+
+    // scope:
+    {
+        auto permit = budget.try_acquire();
+        EXPECT( budget.live() == 1u );
+    }
+
+    EXPECT( budget.live() == 0u );
+    EXPECT( budget.peak() == 1u );
+}
+
+CASE( "resource_governor: a governed resource's deleter refunds the budget" " [extension]" )
+{
+    closed = 0;
+    resource_budget budget( 1 );
+
+    // scope:
+    {
+        auto r = make_governed_resource_checked( budget.try_acquire(), 7, -1, close_handle );
+
+        EXPECT( r.get() == 7 );
+        EXPECT( budget.live() == 1u );
+        EXPECT_NOT( !!budget.try_acquire() );
+    }
+
+    EXPECT( closed == 1 );
+    EXPECT( budget.live() == 0u );
+}
+
+CASE( "resource_governor: an invalid governed resource refunds the budget immediately" " [extension]" )
+{
+    closed = 0;
+    resource_budget budget( 1 );
+
+    auto r = make_governed_resource_checked( budget.try_acquire(), -1, -1, close_handle );
+
+    EXPECT( budget.live() == 0u );
+
+    r.reset();
+
+    EXPECT( closed == 0 );
+    EXPECT( budget.live() == 0u );
+}
+
+CASE( "resource_governor: acquire_for() times out when the budget stays exhausted" " [extension]" )
+{
+    resource_budget budget( 1 );
+
+    auto p1 = budget.try_acquire();
+    auto p2 = budget.acquire_for( std::chrono::milliseconds( 10 ) );
+
+    EXPECT_NOT( !!p2 );
+}
+
+CASE( "resource_governor: acquire() waits for a refund from another thread" " [extension][thread]" )
+{
+    resource_budget budget( 1 );
+
+    auto p1 = budget.try_acquire();
+
+    std::thread releaser( [&]{
+        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+        p1 = budget_permit();
+    });
+
+    auto p2 = budget.acquire();
+    releaser.join();
+
+    EXPECT( !!p2 );
+    EXPECT( budget.live() == 1u );
+}
+
+CASE( "resource_governor: categories are created once and can be visited" " [extension]" )
+{
+    resource_governor governor;
+
+    resource_budget & fds  = governor.category( "fd", 1024 );
+    resource_budget & maps = governor.category( "mapping", 16 );
+
+    EXPECT( &governor.category( "fd", 1 ) == &fds );
+    EXPECT( governor.find( "mapping" ) == &maps );
+    EXPECT( governor.find( "socket" ) == nullptr );
+    EXPECT( fds.limit() == 1024u );
+
+    std::size_t total = 0;
+    governor.for_each( [&]( std::string const &, resource_budget & b ){ total += b.limit(); } );
+
+    EXPECT( total == 1040u );
+}
+
+#else // scope_HAVE_RESOURCE_GOVERNOR
+
+CASE( "resource_governor: not available" " [extension]" )
+{
+    EXPECT( !!"resource_governor is not available (no C++11, or extensions disabled)." );
+}
+
+#endif // scope_HAVE_RESOURCE_GOVERNOR
+
+// end of file
@@ -0,0 +1,111 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "scope-main.t.hpp"
+#include "nonstd/scope/resource_tracking.hpp"
+
+// The tweak header of this test program, hooks/resource_tracking/nonstd/scope.tweak.hpp,
+// installs resource_tracking_hooks; see test/CMakeLists.txt:
+
+#if scope_HAVE_RESOURCE_TRACKING && defined( scope_TEST_RESOURCE_TRACKING_HOOKS )
+
+#include "resource-types.t.hpp"
+
+#include <sstream>
+#include <string>
+#include <utility>
+
+using namespace nonstd;
+
+CASE( "resource_tracking_hooks: count the unique_resources that own a resource" " [extension]" )
+{
+    // scope:
+    {
+        resource<1> a( 1, noop_deleter<1>() );
+        resource<1> b( 2, noop_deleter<1>() );
+        auto c = make_unique_resource_checked( -1, -1, noop_deleter<1>() );
+
+        EXPECT( resource_tracking::snapshot< resource<1> >().live == 2 );
+
+        a.reset( 3 );
+        b.release();
+
+        resource_gauge const g = resource_tracking::snapshot< resource<1> >();
+
+        EXPECT( g.live == 1 );
+        EXPECT( g.acquired == 3u );
+    }
+
+    resource_gauge const g = resource_tracking::snapshot< resource<1> >();
+
+    EXPECT( g.live == 0 );
+    EXPECT( g.peak == 2 );
+}
+
+CASE( "resource_tracking_hooks: a moved unique_resource is counted once" " [extension]" )
+{
+    // scope:
+    {
+        resource<2> a( 1, noop_deleter<2>() );
+        resource<2> b( std::move( a ) );
+
+        EXPECT( resource_tracking::snapshot< resource<2> >().live == 1 );
+    }
+
+    EXPECT( resource_tracking::snapshot< resource<2> >().live == 0 );
+    EXPECT( resource_tracking::snapshot< resource<2> >().acquired == 1u );
+}
+
+CASE( "resource_tracking_hooks: the dump shows the sites of live unique_resources only" " [extension]" )
+{
+    resource_tracking::set_site_sampling( 1 );
+
+    resource<3> live( 31, noop_deleter<3>() );
+
+    // scope:
+    {
+        resource<3> gone( 32, noop_deleter<3>() );
+    }
+
+    resource_tracking::set_site_sampling( 0 );
+
+    std::ostringstream os;
+    dump_live_resources( os );
+
+    EXPECT( os.str().find( "live=1 peak=2 acquired=2" ) != std::string::npos );
+    EXPECT( os.str().find( "handle 31," ) != std::string::npos );
+    EXPECT( os.str().find( "handle 32," ) == std::string::npos );
+}
+
+CASE( "resource_tracking_hooks: do not track guards" " [extension]" )
+{
+    std::size_t types = 0;
+    resource_tracking::for_each( [&]( resource_gauge const & ){ ++types; } );
+
+    // scope:
+    {
+        auto on_exit = make_scope_exit( []{} );
+        auto on_fail = make_scope_fail( []{} );
+    }
+
+    std::size_t types_after = 0;
+    resource_tracking::for_each( [&]( resource_gauge const & ){ ++types_after; } );
+
+    EXPECT( types_after == types );
+}
+
+#else // scope_HAVE_RESOURCE_TRACKING
+
+CASE( "resource_tracking_hooks: not available" " [extension]" )
+{
+    EXPECT( !!"resource_tracking_hooks are not installed (no C++11, or extensions disabled)." );
+}
+
+#endif // scope_HAVE_RESOURCE_TRACKING
+
+// end of file
@@ -0,0 +1,198 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "scope-main.t.hpp"
+#include "nonstd/scope/resource_tracking.hpp"
+
+#if scope_HAVE_RESOURCE_TRACKING
+
+#include "resource-types.t.hpp"
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace nonstd;
+
+namespace {
+
+// The tests call the hooks directly; resource_tracking.hooks.t.cpp installs them:
+
+template< class D >
+void tracked_delete( unique_resource<int, D> & r )
+{
+    auto const token = resource_tracking_hooks::before_delete( r );
+    r.get_deleter()( r.get() );
+    resource_tracking_hooks::after_delete( r, token );
+}
+
+} // anonymous namespace
+
+CASE( "resource_tracking: counts live, peak and acquired resources of a type" " [extension]" )
+{
+    std::vector< resource<1> > rs;
+
+    for ( int i = 0; i < 3; ++i )
+    {
+        rs.push_back( resource<1>( i, noop_deleter<1>() ) );
+        resource_tracking_hooks::on_construct( rs.back() );
+    }
+
+    EXPECT( resource_tracking::snapshot< resource<1> >().live == 3 );
+
+    tracked_delete( rs[0] );
+    resource_tracking_hooks::on_release( rs[1] );
+
+    resource_gauge const g = resource_tracking::snapshot< resource<1> >();
+
+    EXPECT( g.live == 1 );
+    EXPECT( g.peak == 3 );
+    EXPECT( g.acquired == 3u );
+    EXPECT( g.name.find( "noop_deleter<1>" ) != std::string::npos );
+    EXPECT( resource_tracking::snapshot< resource<2> >().acquired == 0u );
+}
+
+CASE( "resource_tracking: refreshes the peak without reads" " [extension]" )
+{
+    std::vector< resource<3> > rs;
+
+    for ( int i = 0; i < 128; ++i )
+    {
+        rs.push_back( resource<3>( i, noop_deleter<3>() ) );
+        resource_tracking_hooks::on_construct( rs.back() );
+    }
+
+    for ( auto & r : rs )
+        tracked_delete( r );
+
+    resource_gauge const g = resource_tracking::snapshot< resource<3> >();
+
+    EXPECT( g.live == 0 );
+    EXPECT( g.peak == 128 );
+}
+
+CASE( "resource_tracking: does not track guards" " [extension]" )
+{
+    std::size_t types = 0;
+    resource_tracking::for_each( [&]( resource_gauge const & ){ ++types; } );
+
+    auto guard = make_scope_exit( []{} );
+
+    resource_tracking_hooks::on_construct( guard );
+    resource_tracking_hooks::after_exit( guard, resource_tracking_hooks::before_exit( guard ) );
+    resource_tracking_hooks::on_release( guard );
+
+    std::size_t types_after = 0;
+    resource_tracking::for_each( [&]( resource_gauge const & ){ ++types_after; } );
+
+    EXPECT( types_after == types );
+}
+
+CASE( "resource_tracking: counts resources over threads, also released on another thread" " [extension][thread]" )
+{
+    std::vector< resource<4> > rs;
+
+    for ( int i = 0; i < 10; ++i )
+    {
+        rs.push_back( resource<4>( i, noop_deleter<4>() ) );
+        resource_tracking_hooks::on_construct( rs.back() );
+    }
+
+    std::vector<std::thread> threads;
+
+    for ( int t = 0; t < 4; ++t )
+    {
+        threads.emplace_back( [t, &rs]
+        {
+            for ( int i = 0; i < 100; ++i )
+            {
+                resource<4> r( 100 + i, noop_deleter<4>() );
+                resource_tracking_hooks::on_construct( r );
+
+                if ( i % 2 )
+                    tracked_delete( r );
+            }
+
+            if ( t == 0 )
+            {
+                for ( auto & r : rs )
+                    tracked_delete( r );
+            }
+        } );
+    }
+
+    for ( auto & t : threads )
+        t.join();
+
+    resource_gauge const g = resource_tracking::snapshot< resource<4> >();
+
+    EXPECT( g.live == 200 );
+    EXPECT( g.acquired == 410u );
+}
+
+CASE( "resource_tracking: samples sites and dumps the live ones" " [extension]" )
+{
+    resource_tracking::set_site_sampling( 1 );
+
+    resource<5> a( 11, noop_deleter<5>() );
+    resource<5> b( 12, noop_deleter<5>() );
+
+    resource_tracking_hooks::on_construct( a );
+    resource_tracking_hooks::on_construct( b );
+    tracked_delete( a );
+
+    resource_tracking::set_site_sampling( 0 );
+
+    std::ostringstream os;
+    dump_live_resources( os );
+
+    EXPECT( os.str().find( "live resources" ) == 0u );
+    EXPECT( os.str().find( "noop_deleter<5>" ) != std::string::npos );
+    EXPECT( os.str().find( "live=1 peak=2 acquired=2" ) != std::string::npos );
+    EXPECT( os.str().find( "handle 12, acquired " ) != std::string::npos );
+    EXPECT( os.str().find( "handle 11," ) == std::string::npos );
+
+    tracked_delete( b );
+}
+
+CASE( "resource_tracking: samples 1 in N sites" " [extension]" )
+{
+    resource_tracking::set_site_sampling( 2 );
+
+    std::vector< resource<6> > rs;
+
+    for ( int i = 0; i < 4; ++i )
+    {
+        rs.push_back( resource<6>( 60 + i, noop_deleter<6>() ) );
+        resource_tracking_hooks::on_construct( rs.back() );
+    }
+
+    resource_tracking::set_site_sampling( 0 );
+
+    std::ostringstream os;
+    dump_live_resources( os );
+
+    EXPECT( os.str().find( "handle 60," ) == std::string::npos );
+    EXPECT( os.str().find( "handle 61," ) != std::string::npos );
+    EXPECT( os.str().find( "handle 62," ) == std::string::npos );
+    EXPECT( os.str().find( "handle 63," ) != std::string::npos );
+
+    for ( auto & r : rs )
+        tracked_delete( r );
+}
+
+#else // scope_HAVE_RESOURCE_TRACKING
+
+CASE( "resource_tracking: not available" " [extension]" )
+{
+    EXPECT( !!"resource_tracking is not available (no C++11, or extensions disabled)." );
+}
+
+#endif // scope_HAVE_RESOURCE_TRACKING
+
+// end of file
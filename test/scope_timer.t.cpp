@@ -0,0 +1,170 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "scope-main.t.hpp"
+#include "nonstd/scope/scope_timer.hpp"
+
+#if scope_HAVE_SCOPE_TIMER
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace nonstd;
+
+namespace {
+
+void sleep_ms( int ms )
+{
+    std::this_thread::sleep_for( std::chrono::milliseconds( ms ) );
+}
+
+} // anonymous namespace
+
+CASE( "scope_timer: records the time its scope took" " [extension]" )
+{
+    latency_sink sink;
+
+    // scope:
+    {
+        auto timer = make_scope_timer( sink );
+        sleep_ms( 5 );
+    }
+
+    latency_histogram const h = sink.snapshot();
+
+    EXPECT( h.count() == 1u );
+    EXPECT( latency_clock::to_nanoseconds( h.quantile( 1.0 ) ) >= 4000000u );
+}
+
+CASE( "scope_timer: a released timer does not record" " [extension]" )
+{
+    latency_sink sink;
+
+    // scope:
+    {
+        auto timer = make_scope_timer( sink );
+        timer.release();
+    }
+
+    EXPECT( sink.snapshot().count() == 0u );
+}
+
+CASE( "scope_timer: calls the callback when its scope exceeds the budget" " [extension]" )
+{
+    latency_sink sink;
+    std::chrono::nanoseconds reported( 0 );
+    int calls = 0;
+
+    // scope:
+    {
+        auto timer = make_scope_timer( sink, std::chrono::milliseconds( 1 ),
+            [&]( std::chrono::nanoseconds elapsed ) { ++calls; reported = elapsed; } );
+        sleep_ms( 5 );
+    }
+
+    // scope:
+    {
+        auto timer = make_scope_timer( sink, std::chrono::seconds( 10 ),
+            [&]( std::chrono::nanoseconds ) { ++calls; } );
+    }
+
+    EXPECT( calls == 1 );
+    EXPECT( reported.count() >= 4000000 );
+    EXPECT( sink.snapshot().count() == 2u );
+}
+
+CASE( "scope_timer: a negative budget is taken as zero" " [extension]" )
+{
+    latency_sink sink;
+    int calls = 0;
+
+    // scope:
+    {
+        auto timer = make_scope_timer( sink, std::chrono::seconds( -1 ),
+            [&]( std::chrono::nanoseconds ) { ++calls; } );
+        sleep_ms( 1 );
+    }
+
+    EXPECT( calls == 1 );
+}
+
+CASE( "scope_fail_timer: records only when its scope exits via an exception" " [extension]" )
+{
+    latency_sink sink;
+
+    // scope:
+    {
+        auto timer = make_scope_fail_timer( sink );
+    }
+
+    try
+    {
+        auto timer = make_scope_fail_timer( sink );
+        throw std::runtime_error( "fail" );
+    }
+    catch ( std::exception const & ) {}
+
+    EXPECT( sink.snapshot().count() == 1u );
+}
+
+CASE( "scope_success_timer: records only when its scope exits normally" " [extension]" )
+{
+    latency_sink sink;
+    int calls = 0;
+
+    // scope:
+    {
+        auto timer = make_scope_success_timer( sink, std::chrono::nanoseconds( 0 ),
+            [&]( std::chrono::nanoseconds ) { ++calls; } );
+        sleep_ms( 1 );
+    }
+
+    try
+    {
+        auto timer = make_scope_success_timer( sink, std::chrono::nanoseconds( 0 ),
+            [&]( std::chrono::nanoseconds ) { ++calls; } );
+        throw std::runtime_error( "fail" );
+    }
+    catch ( std::exception const & ) {}
+
+    EXPECT( sink.snapshot().count() == 1u );
+    EXPECT( calls == 1 );
+}
+
+CASE( "latency_sink: threads add to one sink" " [extension][thread]" )
+{
+    latency_sink sink;
+    std::vector<std::thread> threads;
+
+    for ( int t = 0; t < 4; ++t )
+    {
+        threads.emplace_back( [&sink]
+        {
+            for ( int i = 0; i < 1000; ++i )
+                auto timer = make_scope_timer( sink );
+        } );
+    }
+
+    for ( auto & t : threads )
+        t.join();
+
+    EXPECT( sink.snapshot().count() == 4000u );
+}
+
+#else // scope_HAVE_SCOPE_TIMER
+
+CASE( "scope_timer: not available" " [extension]" )
+{
+    EXPECT( !!"scope_timer is not available (no C++11, or extensions disabled)." );
+}
+
+#endif // scope_HAVE_SCOPE_TIMER
+
+// end of file
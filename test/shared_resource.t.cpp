@@ -0,0 +1,152 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "scope-main.t.hpp"
+#include "nonstd/scope/shared_resource.hpp"
+
+#if scope_HAVE_SHARED_RESOURCE
+
+#include <thread>
+#include <vector>
+
+using namespace nonstd;
+
+namespace {
+
+int close_count = 0;
+
+void close_handle( int ) { ++close_count; }
+
+struct Node { int value; };
+
+} // anonymous namespace
+
+CASE( "shared_resource: the last owner executes the deleter" " [extension]" )
+{
+    close_count = 0;
+
+    // scope:
+    {
+        auto r1 = make_shared_resource_checked( 7, -1, close_handle );
+        {
+            auto r2 = r1;
+
+            EXPECT( r1.use_count() == 2 );
+            EXPECT( r2.get() == 7 );
+        }
+        EXPECT( r1.use_count() == 1 );
+        EXPECT( close_count == 0 );
+    }
+
+    EXPECT( close_count == 1 );
+}
+
+CASE( "shared_resource: an invalid resource is not deleted" " [extension]" )
+{
+    close_count = 0;
+
+    // scope:
+    {
+        auto r = make_shared_resource_checked( -1, -1, close_handle );
+    }
+
+    EXPECT( close_count == 0 );
+}
+
+CASE( "shared_resource: a unique_resource can be converted into a shared_resource" " [extension]" )
+{
+    close_count = 0;
+
+    // scope:
+    {
+        auto u = make_unique_resource_checked( 7, -1, close_handle );
+
+        shared_resource<int, void(*)(int)> s = std::move( u );
+
+        u.reset();
+        EXPECT( close_count == 0 );
+        EXPECT( s.get() == 7 );
+    }
+
+    EXPECT( close_count == 1 );
+}
+
+CASE( "shared_resource: move construction and move assignment transfer the share" " [extension]" )
+{
+    close_count = 0;
+
+    auto r1 = make_shared_resource_checked<nonatomic_count>( 7, -1, close_handle );
+    auto r2( std::move( r1 ) );
+
+    EXPECT_NOT( !!r1 );
+    EXPECT( r2.use_count() == 1 );
+
+    r1 = std::move( r2 );
+
+    EXPECT_NOT( !!r2 );
+    EXPECT( r1.use_count() == 1 );
+    EXPECT( close_count == 0 );
+
+    r1.reset();
+
+    EXPECT_NOT( !!r1 );
+    EXPECT( close_count == 1 );
+}
+
+CASE( "shared_resource: op*() and op->() provide the pointee if the resource handle is a pointer" " [extension]" )
+{
+    struct no { static void op( Node * ){} };
+
+    Node node = { 77 };
+
+    auto r = make_shared_resource_checked( &node, nullptr, no::op );
+
+    EXPECT( (*r).value == 77 );
+    EXPECT( r->value == 77 );
+}
+
+CASE( "shared_resource: the atomic count policy handles concurrent copies" " [extension][thread]" )
+{
+    close_count = 0;
+
+    // scope:
+    {
+        auto r = make_shared_resource_checked<atomic_count>( 7, -1, close_handle );
+
+        std::vector<std::thread> threads;
+
+        for ( int i = 0; i < 4; ++i )
+        {
+            threads.emplace_back( [r]{
+                for ( int k = 0; k < 10000; ++k )
+                {
+                    auto copy = r;
+                }
+            });
+        }
+
+        for ( auto & t : threads )
+            t.join();
+
+        EXPECT( r.use_count() == 1 );
+        EXPECT( close_count == 0 );
+    }
+
+    EXPECT( close_count == 1 );
+}
+
+#else // scope_HAVE_SHARED_RESOURCE
+
+CASE( "shared_resource: not available" " [extension]" )
+{
+    EXPECT( !!"shared_resource is not available (no C++11, or extensions disabled)." );
+}
+
+#endif // scope_HAVE_SHARED_RESOURCE
+
+// end of file
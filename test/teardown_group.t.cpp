@@ -0,0 +1,130 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "scope-main.t.hpp"
+#include "nonstd/scope/teardown_group.hpp"
+
+#if scope_HAVE_TEARDOWN_GROUP
+
+#include <mutex>
+#include <string>
+
+using namespace nonstd;
+
+namespace {
+
+std::mutex trace_mutex;
+std::string trace;
+
+struct append
+{
+    void operator()() const
+    {
+        std::lock_guard<std::mutex> lock( trace_mutex );
+        trace += text;
+    }
+
+    std::string text;
+};
+
+void close_handle( int i )
+{
+    std::lock_guard<std::mutex> lock( trace_mutex );
+    trace += char( '0' + i );
+}
+
+} // anonymous namespace
+
+CASE( "teardown_group: actions within a group run in reverse order of registration" " [extension]" )
+{
+    trace.clear();
+    teardown_plan plan;
+
+    plan.group( "g" ).add( append{ "1" } ).add( append{ "2" } ).add( append{ "3" } );
+
+    plan.teardown( 1 );
+
+    EXPECT( trace == "321" );
+}
+
+CASE( "teardown_group: a group is torn down after the groups that depend on it" " [extension][thread]" )
+{
+    trace.clear();
+    teardown_plan plan;
+
+    plan.group( "storage" ).add( append{ "S" } );
+    plan.group( "cache"   ).add( append{ "C" } ).depends_on( "storage" );
+    plan.group( "server"  ).add( append{ "V" } ).depends_on( "cache" ).depends_on( "storage" );
+
+    plan.teardown( 4 );
+
+    EXPECT( trace == "VCS" );
+}
+
+CASE( "teardown_group: independent groups are all torn down" " [extension][thread]" )
+{
+    trace.clear();
+    teardown_plan plan;
+
+    for ( int i = 0; i < 8; ++i )
+    {
+        teardown_group & g = plan.group( "shard" + std::to_string( i ) );
+
+        for ( int k = 0; k < 100; ++k )
+            g.add( append{ "." } );
+    }
+
+    auto const reports = plan.teardown( 4 );
+
+    EXPECT( trace.size() == 800u );
+    EXPECT( reports.size() == 8u );
+    EXPECT( reports[3].name == "shard3" );
+    EXPECT( reports[3].actions == 100u );
+}
+
+CASE( "teardown_group: an adopted unique_resource is released with its group" " [extension]" )
+{
+    trace.clear();
+
+    // scope:
+    {
+        teardown_plan plan;
+
+        plan.group( "files" )
+            .adopt( make_unique_resource_checked( 1, -1, close_handle ) )
+            .adopt( make_unique_resource_checked( 2, -1, close_handle ) );
+
+        EXPECT( trace == "" );
+    }
+
+    EXPECT( trace == "21" );
+}
+
+CASE( "teardown_group: a dependency cycle is reported before anything is released" " [extension]" )
+{
+    trace.clear();
+    teardown_plan plan;
+
+    plan.group( "a" ).add( append{ "a" } ).depends_on( "b" );
+    plan.group( "b" ).add( append{ "b" } ).depends_on( "a" );
+
+    EXPECT_THROWS_AS( plan.teardown(), std::logic_error );
+    EXPECT( trace == "" );
+    EXPECT_THROWS_AS( plan.group( "a" ).depends_on( "a" ), std::logic_error );
+}
+
+#else // scope_HAVE_TEARDOWN_GROUP
+
+CASE( "teardown_group: not available" " [extension]" )
+{
+    EXPECT( !!"teardown_group is not available (no C++11, or extensions disabled)." );
+}
+
+#endif // scope_HAVE_TEARDOWN_GROUP
+
+// end of file
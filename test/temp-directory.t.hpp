@@ -0,0 +1,76 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TEST_SCOPE_LITE_TEMP_DIRECTORY_H_INCLUDED
+#define TEST_SCOPE_LITE_TEMP_DIRECTORY_H_INCLUDED
+
+#include <dirent.h>
+#include <ftw.h>
+#include <sys/stat.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+// A fresh directory under /tmp, removed with its contents at the end of the test:
+
+struct temp_directory
+{
+    explicit temp_directory( char const * prefix = "scope-lite" )
+    {
+        std::string templ = std::string( "/tmp/" ) + prefix + "-XXXXXX";
+
+        if ( ::mkdtemp( &templ[0] ) == nullptr )
+            throw std::runtime_error( "temp_directory: mkdtemp() failed: " + std::string( std::strerror( errno ) ) );
+
+        path = templ;
+    }
+
+    ~temp_directory()
+    {
+        (void) ::nftw( path.c_str(), remove_entry, 16, FTW_DEPTH | FTW_PHYS );
+    }
+
+    std::size_t entries() const
+    {
+        std::size_t n = 0;
+        DIR * d = ::opendir( path.c_str() );
+
+        while ( dirent * e = ::readdir( d ) )
+        {
+            if ( std::string( e->d_name ) != "." && std::string( e->d_name ) != ".." )
+                ++n;
+        }
+
+        ::closedir( d );
+        return n;
+    }
+
+    temp_directory( temp_directory const & ) = delete;
+    temp_directory & operator=( temp_directory const & ) = delete;
+
+    std::string path;
+
+private:
+    static int remove_entry( char const * name, struct stat const *, int, FTW * )
+    {
+        (void) std::remove( name );
+        return 0;
+    }
+};
+
+} // anonymous namespace
+
+#endif // TEST_SCOPE_LITE_TEMP_DIRECTORY_H_INCLUDED
+
+// end of file
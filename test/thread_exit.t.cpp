@@ -0,0 +1,109 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "scope-main.t.hpp"
+#include "nonstd/scope/thread_exit.hpp"
+
+#if scope_HAVE_THREAD_EXIT
+
+#include <string>
+#include <thread>
+
+using namespace nonstd;
+
+namespace {
+
+std::string trace;
+
+struct large_action
+{
+    void operator()() const { trace += "L"; }
+
+    char payload[ 2 * scope_thread_exit::slot_size ];
+};
+
+} // anonymous namespace
+
+CASE( "on_thread_exit: actions run when the thread exits, most recently registered first" " [extension][thread]" )
+{
+    trace.clear();
+
+    std::thread( []{
+        on_thread_exit( []{ trace += "1"; } );
+        on_thread_exit( []{ trace += "2"; } );
+        on_thread_exit( []{ trace += "3"; } );
+        trace += "-";
+    }).join();
+
+    EXPECT( trace == "-321" );
+}
+
+CASE( "on_thread_exit: actions beyond the inline capacity keep their order" " [extension][thread]" )
+{
+    trace.clear();
+
+    std::thread( [&]{
+        on_thread_exit( large_action() );
+
+        for ( int i = 0; i < scope_thread_exit::capacity + 4; ++i )
+            on_thread_exit( [i]{ trace += char( 'a' + i % 26 ); } );
+
+        EXPECT( scope_thread_exit::size() == std::size_t( scope_thread_exit::capacity + 5 ) );
+    }).join();
+
+    std::string expected;
+    for ( int i = scope_thread_exit::capacity + 3; i >= 0; --i )
+        expected += char( 'a' + i % 26 );
+    expected += "L";
+
+    EXPECT( trace == expected );
+}
+
+CASE( "scope_thread_exit: execute() runs the registered actions now" " [extension][thread]" )
+{
+    trace.clear();
+
+    std::thread( [&]{
+        on_thread_exit( []{ trace += "1"; } );
+        on_thread_exit( []{ trace += "2"; } );
+
+        scope_thread_exit::execute();
+        trace += "-";
+
+        EXPECT( scope_thread_exit::size() == 0u );
+        on_thread_exit( []{ trace += "3"; } );
+    }).join();
+
+    EXPECT( trace == "21-3" );
+}
+
+CASE( "scope_thread_exit: an action may register further actions" " [extension][thread]" )
+{
+    trace.clear();
+
+    std::thread( []{
+        on_thread_exit( []{ trace += "1"; } );
+        on_thread_exit( []{
+            trace += "2";
+            on_thread_exit( []{ trace += "3"; } );
+        });
+    }).join();
+
+    EXPECT( trace == "231" );
+}
+
+#else // scope_HAVE_THREAD_EXIT
+
+CASE( "on_thread_exit: not available" " [extension]" )
+{
+    EXPECT( !!"on_thread_exit is not available (no C++11, or extensions disabled)." );
+}
+
+#endif // scope_HAVE_THREAD_EXIT
+
+// end of file
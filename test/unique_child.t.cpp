@@ -0,0 +1,225 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "scope-main.t.hpp"
+#include "nonstd/scope/unique_child.hpp"
+
+#if scope_HAVE_UNIQUE_CHILD
+
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <thread>
+
+using namespace nonstd;
+
+namespace {
+
+pid_t spawn_exit( int code )
+{
+    pid_t const pid = ::fork();
+
+    if ( pid == 0 )
+        ::_exit( code );
+
+    return pid;
+}
+
+pid_t spawn_pause()
+{
+    pid_t const pid = ::fork();
+
+    if ( pid == 0 )
+    {
+        for ( ;; )
+            ::pause();
+    }
+
+    return pid;
+}
+
+// true if pid is no longer a child of this process, as it was reaped:
+
+bool is_reaped( pid_t pid )
+{
+    return ::waitpid( pid, nullptr, WNOHANG ) == -1 && errno == ECHILD;
+}
+
+template< class Pred >
+bool eventually( Pred pred )
+{
+    for ( int i = 0; i < 500; ++i )
+    {
+        if ( pred() )
+            return true;
+
+        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+    }
+    return false;
+}
+
+} // anonymous namespace
+
+CASE( "unique_child: gives the exit status of a child" " [extension]" )
+{
+    unique_child child = make_unique_child( spawn_exit( 7 ) );
+
+    EXPECT( !!child );
+    EXPECT( child.wait() );
+    EXPECT( child.has_exited() );
+    EXPECT( WIFEXITED( child.status() ) );
+    EXPECT( WEXITSTATUS( child.status() ) == 7 );
+    EXPECT( child.try_wait() );
+}
+
+CASE( "unique_child: try_wait() does not block on a running child" " [extension]" )
+{
+    unique_child child = make_unique_child( spawn_pause(), unique_child::kill_and_reap );
+    pid_t const pid = child.pid();
+
+    EXPECT_NOT( child.try_wait() );
+    EXPECT_NOT( child.has_exited() );
+
+    EXPECT( child.kill( SIGTERM ) );
+    EXPECT( eventually( [&]{ return child.try_wait(); } ) );
+    EXPECT( WIFSIGNALED( child.status() ) );
+    EXPECT( WTERMSIG( child.status() ) == SIGTERM );
+    EXPECT( is_reaped( pid ) );
+}
+
+CASE( "unique_child: kill_and_reap kills and reaps a running child on destruction" " [extension]" )
+{
+    pid_t pid = -1;
+
+    // scope:
+    {
+        unique_child child = make_unique_child( spawn_pause(), unique_child::kill_and_reap );
+        pid = child.pid();
+    }
+
+    EXPECT( is_reaped( pid ) );
+}
+
+CASE( "unique_child: the reaper reaps children that exit after their owner is gone" " [extension][thread]" )
+{
+    child_reaper reaper;
+    pid_t pids[ 8 ];
+
+    for ( auto & pid : pids )
+    {
+        unique_child child = make_unique_child( spawn_exit( 0 ), unique_child::reap_in_background, reaper );
+        pid = child.pid();
+    }
+
+    EXPECT( eventually( [&]{ return reaper.reaped() == 8u; } ) );
+    EXPECT( reaper.pending() == 0u );
+
+    for ( pid_t pid : pids )
+        EXPECT( is_reaped( pid ) );
+}
+
+CASE( "unique_child: kill_and_reap_in_background hands a killed child to the reaper" " [extension][thread]" )
+{
+    child_reaper reaper;
+    pid_t pid = -1;
+
+    // scope:
+    {
+        unique_child child = make_unique_child( spawn_pause(), unique_child::kill_and_reap_in_background, reaper );
+        pid = child.pid();
+    }
+
+    EXPECT( eventually( [&]{ return reaper.reaped() == 1u; } ) );
+    EXPECT( is_reaped( pid ) );
+}
+
+CASE( "unique_child: the reaper's destructor leaves running children be" " [extension][thread]" )
+{
+    pid_t pid = -1;
+
+    // scope:
+    {
+        child_reaper reaper;
+        unique_child child = make_unique_child( spawn_pause(), unique_child::reap_in_background, reaper );
+        pid = child.pid();
+
+        child.reset();
+
+        EXPECT( reaper.pending() == 1u );
+    }
+
+    EXPECT_NOT( is_reaped( pid ) );
+
+    ::kill( pid, SIGKILL );
+    EXPECT( ::waitpid( pid, nullptr, 0 ) == pid );
+}
+
+CASE( "unique_child: moves ownership" " [extension]" )
+{
+    unique_child a = make_unique_child( spawn_exit( 0 ), unique_child::kill_and_reap );
+    pid_t const pid = a.pid();
+
+    unique_child b( std::move( a ) );
+
+    EXPECT_NOT( !!a );
+    EXPECT( a.pid() == -1 );
+    EXPECT( b.pid() == pid );
+    EXPECT( b.get_release_policy() == unique_child::kill_and_reap );
+    EXPECT( b.wait() );
+}
+
+CASE( "unique_child: a pid that is not a child owns nothing" " [extension]" )
+{
+    unique_child child = make_unique_child( -1 );
+
+    EXPECT_NOT( !!child );
+    EXPECT_NOT( child.try_wait() );
+}
+
+CASE( "unique_child: a reaper without its eventfd is not available, and the child is reaped here" " [extension]" )
+{
+    // Only the lowest free descriptor can be allocated, by the reaper's epoll instance:
+
+    rlimit const saved = []{ rlimit r; ::getrlimit( RLIMIT_NOFILE, &r ); return r; }();
+    int const lowest = ::dup( 0 );
+    ::close( lowest );
+
+    rlimit one_more = saved;
+    one_more.rlim_cur = static_cast<rlim_t>( lowest + 1 );
+    ::setrlimit( RLIMIT_NOFILE, &one_more );
+
+    child_reaper reaper;
+
+    ::setrlimit( RLIMIT_NOFILE, &saved );
+
+    pid_t const pid = spawn_exit( 0 );
+
+    // scope:
+    {
+        unique_child child = make_unique_child( pid, unique_child::reap_in_background, reaper );
+        EXPECT( !!child );
+    }
+
+    EXPECT( is_reaped( pid ) );
+    EXPECT( reaper.pending() == 0u );
+}
+
+#else // scope_HAVE_UNIQUE_CHILD
+
+CASE( "unique_child: not available" " [extension]" )
+{
+    EXPECT( !!"unique_child is not available (no C++11, not Linux, or extensions disabled)." );
+}
+
+#endif // scope_HAVE_UNIQUE_CHILD
+
+// end of file
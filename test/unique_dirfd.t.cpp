@@ -0,0 +1,161 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "scope-main.t.hpp"
+#include "nonstd/scope/unique_dirfd.hpp"
+
+#if scope_HAVE_UNIQUE_DIRFD
+
+#include "temp-directory.t.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <string>
+
+using namespace nonstd;
+
+namespace {
+
+bool exists( std::string const & path )
+{
+    struct stat st;
+    return ::stat( path.c_str(), &st ) == 0;
+}
+
+bool is_open( int fd )
+{
+    return ::fcntl( fd, F_GETFD ) != -1;
+}
+
+} // anonymous namespace
+
+CASE( "unique_dirfd: is the size of an int" " [extension]" )
+{
+    EXPECT( sizeof( unique_dirfd ) == sizeof( int ) );
+}
+
+CASE( "unique_dirfd: closes its descriptor on destruction" " [extension]" )
+{
+    temp_directory tmp( "scope-lite-dirfd" );
+    int fd = -1;
+
+    // scope:
+    {
+        unique_dirfd dir = open_directory( tmp.path.c_str() );
+        fd = dir.get();
+
+        EXPECT( !!dir );
+        EXPECT( is_open( fd ) );
+        EXPECT( ( ::fcntl( fd, F_GETFD ) & FD_CLOEXEC ) != 0 );
+    }
+
+    EXPECT_NOT( is_open( fd ) );
+}
+
+CASE( "unique_dirfd: opening a missing directory or a file as directory owns nothing" " [extension]" )
+{
+    temp_directory tmp( "scope-lite-dirfd" );
+
+    unique_dirfd missing = open_directory( ( tmp.path + "/missing" ).c_str() );
+    int const missing_errno = errno;
+
+    EXPECT_NOT( !!missing );
+    EXPECT( missing_errno == ENOENT );
+
+    unique_dirfd dir = open_directory( tmp.path.c_str() );
+    dir.open( "file", O_WRONLY | O_CREAT | O_CLOEXEC );
+
+    unique_dirfd not_a_directory = dir.open_directory( "file" );
+    int const not_a_directory_errno = errno;
+
+    EXPECT_NOT( !!not_a_directory );
+    EXPECT( not_a_directory_errno == ENOTDIR );
+}
+
+CASE( "unique_dirfd: opens and creates files relative to the directory" " [extension]" )
+{
+    temp_directory tmp( "scope-lite-dirfd" );
+    unique_dirfd dir = open_directory( tmp.path.c_str() );
+
+    // scope:
+    {
+        unique_fd file = dir.open( "segment-1", O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0600 );
+
+        EXPECT( !!file );
+        EXPECT( ::write( file.get(), "x", 1 ) == 1 );
+    }
+
+    EXPECT( exists( tmp.path + "/segment-1" ) );
+
+    unique_fd again = dir.open( "segment-1", O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0600 );
+    int const again_errno = errno;
+
+    EXPECT_NOT( !!again );
+    EXPECT( again_errno == EEXIST );
+}
+
+CASE( "unique_dirfd: creates or opens subdirectories" " [extension]" )
+{
+    temp_directory tmp( "scope-lite-dirfd" );
+    unique_dirfd dir = open_directory( tmp.path.c_str() );
+
+    unique_dirfd sub  = dir.make_directory( "shard-0" );
+    unique_dirfd same = dir.make_directory( "shard-0" );
+    unique_dirfd deep = sub.make_directory( "level-1" ).make_directory( "level-2" );
+
+    EXPECT( !!sub );
+    EXPECT( !!same );
+    EXPECT( !!deep );
+
+    EXPECT( !!deep.open( "segment", O_WRONLY | O_CREAT | O_CLOEXEC ) );
+    EXPECT( exists( tmp.path + "/shard-0/level-1/level-2/segment" ) );
+}
+
+CASE( "unique_dirfd: removes files and empty directories" " [extension]" )
+{
+    temp_directory tmp( "scope-lite-dirfd" );
+    unique_dirfd dir = open_directory( tmp.path.c_str() );
+
+    dir.open( "file", O_WRONLY | O_CREAT | O_CLOEXEC );
+    dir.make_directory( "sub" );
+
+    EXPECT( dir.unlink( "file" ) );
+    EXPECT( dir.unlink( "sub", AT_REMOVEDIR ) );
+    EXPECT_NOT( dir.unlink( "file" ) );
+
+    EXPECT_NOT( exists( tmp.path + "/file" ) );
+    EXPECT_NOT( exists( tmp.path + "/sub" ) );
+}
+
+CASE( "unique_dirfd: moves ownership" " [extension]" )
+{
+    temp_directory tmp( "scope-lite-dirfd" );
+
+    unique_dirfd a = open_directory( tmp.path.c_str() );
+    int const fd = a.get();
+
+    unique_dirfd b( std::move( a ) );
+
+    EXPECT( a.get() == -1 );
+    EXPECT( b.get() == fd );
+    EXPECT( is_open( fd ) );
+}
+
+#else // scope_HAVE_UNIQUE_DIRFD
+
+CASE( "unique_dirfd: not available" " [extension]" )
+{
+    EXPECT( !!"unique_dirfd is not available (no C++11, no <unistd.h>, or extensions disabled)." );
+}
+
+#endif // scope_HAVE_UNIQUE_DIRFD
+
+// end of file
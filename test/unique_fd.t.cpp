@@ -0,0 +1,198 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "scope-main.t.hpp"
+#include "nonstd/scope/unique_fd.hpp"
+
+#if scope_HAVE_UNIQUE_FD
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <vector>
+
+using namespace nonstd;
+
+namespace {
+
+int open_null()
+{
+    return ::open( "/dev/null", O_RDONLY );
+}
+
+bool is_open( int fd )
+{
+    return ::fcntl( fd, F_GETFD ) != -1;
+}
+
+} // anonymous namespace
+
+CASE( "unique_fd: is the size of an int" " [extension]" )
+{
+    EXPECT( sizeof( unique_fd ) == sizeof( int ) );
+}
+
+CASE( "unique_fd: closes its descriptor on destruction" " [extension]" )
+{
+    int fd = -1;
+
+    // scope:
+    {
+        unique_fd ufd( open_null() );
+        fd = ufd.get();
+
+        EXPECT( !!ufd );
+        EXPECT( is_open( fd ) );
+    }
+
+    EXPECT_NOT( is_open( fd ) );
+}
+
+CASE( "unique_fd: -1 owns nothing" " [extension]" )
+{
+    unique_fd a;
+    unique_fd b( -1 );
+
+    EXPECT_NOT( !!a );
+    EXPECT_NOT( !!b );
+    EXPECT( a.get() == -1 );
+}
+
+CASE( "unique_fd: moves ownership" " [extension]" )
+{
+    unique_fd a( open_null() );
+    int const fd = a.get();
+
+    unique_fd b( std::move( a ) );
+
+    EXPECT( a.get() == -1 );
+    EXPECT( b.get() == fd );
+
+    unique_fd c;
+    c = std::move( b );
+
+    EXPECT( b.get() == -1 );
+    EXPECT( c.get() == fd );
+    EXPECT( is_open( fd ) );
+}
+
+CASE( "unique_fd: reset() closes, release() does not" " [extension]" )
+{
+    unique_fd a( open_null() );
+    int const fd1 = a.get();
+
+    a.reset( open_null() );
+    int const fd2 = a.get();
+
+    EXPECT_NOT( is_open( fd1 ) );
+    EXPECT( is_open( fd2 ) );
+
+    a.release();
+
+    EXPECT( a.get() == -1 );
+    EXPECT( is_open( fd2 ) );
+
+    ::close( fd2 );
+}
+
+CASE( "unique_fd_set: closes all its descriptors on destruction" " [extension]" )
+{
+    std::vector<int> fds;
+
+    // scope:
+    {
+        unique_fd_set set;
+
+        for ( int i = 0; i < 50; ++i )
+        {
+            fds.push_back( open_null() );
+            set.insert( fds.back() );
+        }
+
+        set.adopt( unique_fd( open_null() ) );
+        fds.push_back( ::dup( fds.front() ) );
+        set.insert( fds.back() );
+
+        EXPECT( set.size() == 52u );
+    }
+
+    for ( int fd : fds )
+        EXPECT_NOT( is_open( fd ) );
+}
+
+CASE( "unique_fd_set: closes a run of consecutive descriptors with one close_range()" " [extension]" )
+{
+    int const src = open_null();
+    int const base = 900;
+
+    unique_fd_set set;
+
+    for ( int i = 0; i < 16; ++i )
+        set.insert( ::dup2( src, base + 15 - i ) );
+
+    set.insert( ::dup2( src, base + 20 ) );
+
+    std::size_t const calls = set.close_all();
+
+    EXPECT( calls == ( unique_fd_set::has_close_range() ? 2u : 17u ) );
+    EXPECT( set.empty() );
+
+    for ( int i = 0; i <= 20; ++i )
+        EXPECT_NOT( is_open( base + i ) );
+
+    EXPECT( is_open( src ) );
+    ::close( src );
+}
+
+CASE( "unique_fd_set: closes a descriptor added twice once" " [extension]" )
+{
+    int const fd = open_null();
+
+    unique_fd_set set;
+    set.insert( fd );
+    set.insert( fd );
+
+    EXPECT( set.close_all() == 1u );
+    EXPECT_NOT( is_open( fd ) );
+}
+
+CASE( "unique_fd_set: take() gives up ownership of a descriptor" " [extension]" )
+{
+    int const fd1 = open_null();
+    int const fd2 = open_null();
+
+    unique_fd taken;
+
+    // scope:
+    {
+        unique_fd_set set;
+        set.insert( fd1 );
+        set.insert( fd2 );
+
+        taken = set.take( fd1 );
+
+        EXPECT( taken.get() == fd1 );
+        EXPECT_NOT( set.contains( fd1 ) );
+        EXPECT( set.contains( fd2 ) );
+        EXPECT( set.take( 12345 ).get() == -1 );
+    }
+
+    EXPECT( is_open( fd1 ) );
+    EXPECT_NOT( is_open( fd2 ) );
+}
+
+#else // scope_HAVE_UNIQUE_FD
+
+CASE( "unique_fd: not available" " [extension]" )
+{
+    EXPECT( !!"unique_fd is not available (no C++11, no <unistd.h>, or extensions disabled)." );
+}
+
+#endif // scope_HAVE_UNIQUE_FD
+
+// end of file
@@ -0,0 +1,235 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "scope-main.t.hpp"
+#include "nonstd/scope/unique_mapping.hpp"
+
+#if scope_HAVE_UNIQUE_MAPPING
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+using namespace nonstd;
+
+namespace {
+
+// msync() fails with ENOMEM on a range that is not mapped:
+
+bool is_mapped( void * p, std::size_t length )
+{
+    return ::msync( p, length, MS_ASYNC ) == 0;
+}
+
+bool all_zero( unique_mapping const & m )
+{
+    for ( std::size_t i = 0; i < m.size(); ++i )
+    {
+        if ( m.data()[ i ] != 0 )
+            return false;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+CASE( "unique_mapping: is the size of a pointer and a length" " [extension]" )
+{
+    EXPECT( sizeof( unique_mapping ) == sizeof( void * ) + sizeof( std::size_t ) );
+}
+
+CASE( "unique_mapping: unmaps its region on destruction" " [extension]" )
+{
+    void * p = nullptr;
+
+    // scope:
+    {
+        unique_mapping m = make_anonymous_mapping( 3 * 4096 );
+
+        EXPECT( !!m );
+        EXPECT( m.size() == 3 * 4096u );
+        EXPECT( all_zero( m ) );
+
+        m.data()[ m.size() - 1 ] = 42;
+        p = m.get();
+
+        EXPECT( is_mapped( p, 3 * 4096 ) );
+    }
+
+    EXPECT_NOT( is_mapped( p, 3 * 4096 ) );
+}
+
+CASE( "unique_mapping: a null address owns nothing" " [extension]" )
+{
+    unique_mapping a;
+    unique_mapping b( nullptr, 4096 );
+
+    EXPECT_NOT( !!a );
+    EXPECT_NOT( !!b );
+    EXPECT( b.size() == 0u );
+}
+
+CASE( "unique_mapping: moves ownership" " [extension]" )
+{
+    unique_mapping a = make_anonymous_mapping( 4096 );
+    void * const p = a.get();
+
+    unique_mapping b( std::move( a ) );
+
+    EXPECT( a.get() == nullptr );
+    EXPECT( b.get() == p );
+    EXPECT( b.size() == 4096u );
+
+    unique_mapping c;
+    c = std::move( b );
+
+    EXPECT( b.get() == nullptr );
+    EXPECT( c.get() == p );
+    EXPECT( is_mapped( p, 4096 ) );
+}
+
+CASE( "unique_mapping: release() gives up ownership" " [extension]" )
+{
+    void * p = nullptr;
+
+    // scope:
+    {
+        unique_mapping m = make_anonymous_mapping( 4096 );
+        p = m.get();
+        m.release();
+    }
+
+    EXPECT( is_mapped( p, 4096 ) );
+    ::munmap( p, 4096 );
+}
+
+CASE( "unique_mapping: populates, advises and locks" " [extension]" )
+{
+    unique_mapping m = make_anonymous_mapping( 16 * 4096,
+        unique_mapping::map_populate | unique_mapping::advise_random | unique_mapping::map_locked );
+
+    EXPECT( !!m );
+    EXPECT( all_zero( m ) );
+    EXPECT( m.advise( unique_mapping::sequential ) );
+    EXPECT( m.advise( unique_mapping::willneed, 4096, 4096 ) );
+    EXPECT( m.unlock() );
+}
+
+CASE( "unique_mapping: dontneed advice discards the contents of private memory" " [extension]" )
+{
+    unique_mapping m = make_anonymous_mapping( 4096 );
+
+    m.data()[ 0 ] = 42;
+
+    EXPECT( m.advise( unique_mapping::dontneed ) );
+    EXPECT( m.data()[ 0 ] == 0 );
+}
+
+CASE( "unique_mapping: huge pages are aligned and rounded up, with or without reserved huge pages" " [extension]" )
+{
+    std::size_t const huge = scope_CONFIG_HUGE_PAGE_SIZE;
+
+    unique_mapping explicit_huge = make_anonymous_mapping( 3 * 4096, unique_mapping::map_huge_pages | unique_mapping::map_populate );
+    unique_mapping transparent   = make_anonymous_mapping( huge + 1, unique_mapping::map_transparent_huge_pages );
+
+    EXPECT( !!explicit_huge );
+    EXPECT( explicit_huge.size() == huge );
+    EXPECT( reinterpret_cast<std::uintptr_t>( explicit_huge.get() ) % huge == 0u );
+    EXPECT( all_zero( explicit_huge ) );
+
+    EXPECT( !!transparent );
+    EXPECT( transparent.size() == 2 * huge );
+    EXPECT( reinterpret_cast<std::uintptr_t>( transparent.get() ) % huge == 0u );
+
+    transparent.data()[ transparent.size() - 1 ] = 1;
+}
+
+CASE( "unique_mapping: maps a file, shared or copy-on-write" " [extension]" )
+{
+    char path[] = "/tmp/scope-lite-mapping-XXXXXX";
+    int const fd = ::mkstemp( path );
+    ::unlink( path );
+
+    char const text[] = "unique_mapping";
+    EXPECT( ::write( fd, text, sizeof( text ) ) == ssize_t( sizeof( text ) ) );
+
+    // scope:
+    {
+        unique_mapping whole = make_file_mapping( fd );
+
+        EXPECT( whole.size() == sizeof( text ) );
+        EXPECT( std::memcmp( whole.data(), text, sizeof( text ) ) == 0 );
+    }
+
+    // scope:
+    {
+        unique_mapping cow    = make_file_mapping( fd, sizeof( text ), PROT_READ | PROT_WRITE, unique_mapping::map_copy_on_write );
+        unique_mapping shared = make_file_mapping( fd, sizeof( text ), PROT_READ | PROT_WRITE );
+
+        cow.data()[ 0 ] = 'U';
+
+        EXPECT( shared.data()[ 0 ] == 'u' );
+
+        shared.data()[ 1 ] = 'N';
+    }
+
+    char buffer[ sizeof( text ) ] = {};
+    EXPECT( ::pread( fd, buffer, sizeof( buffer ), 0 ) == ssize_t( sizeof( text ) ) );
+    EXPECT( std::strcmp( buffer, "uNique_mapping" ) == 0 );
+
+    ::close( fd );
+}
+
+CASE( "unique_mapping: a failed mapping owns nothing and keeps errno" " [extension]" )
+{
+    unique_mapping bad_fd = make_file_mapping( -1, 4096 );
+    int const bad_fd_errno = errno;
+
+    EXPECT_NOT( !!bad_fd );
+    EXPECT( bad_fd_errno == EBADF );
+
+    int const fd = ::open( "/dev/null", O_RDONLY );
+    unique_mapping empty = make_file_mapping( fd );
+    int const empty_errno = errno;
+    ::close( fd );
+
+    EXPECT_NOT( !!empty );
+    EXPECT( empty_errno == EINVAL );
+}
+
+CASE( "unmap_region: unmaps a mapping owned by a unique_resource" " [extension]" )
+{
+    unique_mapping m = make_anonymous_mapping( 2 * 4096 );
+    void * const p = m.get();
+
+    // scope:
+    {
+        unique_resource<void *, unmap_region> r( p, unmap_region( m.size() ) );
+        m.release();
+
+        EXPECT( is_mapped( p, 2 * 4096 ) );
+    }
+
+    EXPECT_NOT( is_mapped( p, 2 * 4096 ) );
+}
+
+#else // scope_HAVE_UNIQUE_MAPPING
+
+CASE( "unique_mapping: not available" " [extension]" )
+{
+    EXPECT( !!"unique_mapping is not available (no C++11, no <sys/mman.h>, or extensions disabled)." );
+}
+
+#endif // scope_HAVE_UNIQUE_MAPPING
+
+// end of file
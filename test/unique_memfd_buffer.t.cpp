@@ -0,0 +1,140 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "scope-main.t.hpp"
+#include "nonstd/scope/unique_memfd_buffer.hpp"
+
+#if scope_HAVE_UNIQUE_MEMFD_BUFFER
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+using namespace nonstd;
+
+CASE( "unique_memfd_buffer: creates a zeroed, writable buffer of the given size" " [extension]" )
+{
+    unique_memfd_buffer buffer = make_memfd_buffer( "scope-lite-test", 3 * 4096 );
+
+    EXPECT( !!buffer );
+    EXPECT( buffer.size() == 3 * 4096u );
+    EXPECT( buffer.data() != nullptr );
+    EXPECT( buffer.data()[ 0 ] == 0 );
+
+    buffer.data()[ buffer.size() - 1 ] = 42;
+
+    EXPECT( buffer.data()[ buffer.size() - 1 ] == 42 );
+}
+
+CASE( "unique_memfd_buffer: a read-only mapping outlives the buffer" " [extension]" )
+{
+    unique_mapping reader;
+
+    // scope:
+    {
+        unique_memfd_buffer buffer = make_memfd_buffer( "scope-lite-test", 4096 );
+        std::strcpy( reinterpret_cast<char *>( buffer.data() ), "handoff" );
+
+        reader = buffer.map_read_only();
+    }
+
+    EXPECT( !!reader );
+    EXPECT( reader.size() == 4096u );
+    EXPECT( std::strcmp( reinterpret_cast<char const *>( reader.data() ), "handoff" ) == 0 );
+}
+
+CASE( "unique_memfd_buffer: seal_write requires that the producer unmaps first" " [extension]" )
+{
+    unique_memfd_buffer buffer = make_memfd_buffer( "scope-lite-test", 4096 );
+
+    EXPECT_NOT( buffer.seal( unique_memfd_buffer::seal_write ) );
+    EXPECT( errno == EBUSY );
+
+    buffer.unmap();
+
+    EXPECT( buffer.data() == nullptr );
+    EXPECT( buffer.seal( unique_memfd_buffer::seal_immutable ) );
+    EXPECT( buffer.sealed() == unsigned( unique_memfd_buffer::seal_immutable ) );
+
+    EXPECT( ::write( buffer.get(), "x", 1 ) == -1 );
+    EXPECT( ::ftruncate( buffer.get(), 8192 ) == -1 );
+    EXPECT_NOT( buffer.seal( unique_memfd_buffer::seal_grow ) );
+    EXPECT( !!buffer.map_read_only() );
+    EXPECT_NOT( !!make_file_mapping( buffer.get(), 4096, PROT_READ | PROT_WRITE ) );
+}
+
+CASE( "unique_memfd_buffer: moves ownership" " [extension]" )
+{
+    unique_memfd_buffer a = make_memfd_buffer( "scope-lite-test", 4096 );
+    int const fd = a.get();
+
+    unique_memfd_buffer b( std::move( a ) );
+
+    EXPECT( a.get() == -1 );
+    EXPECT( a.size() == 0u );
+    EXPECT( b.get() == fd );
+    EXPECT( b.size() == 4096u );
+}
+
+CASE( "unique_memfd_buffer: a child process reads the sealed buffer via a duplicate descriptor" " [extension]" )
+{
+    unique_memfd_buffer buffer = make_memfd_buffer( "scope-lite-test", 8192 );
+    std::memset( buffer.data(), 'm', buffer.size() );
+
+    buffer.unmap();
+    EXPECT( buffer.seal( unique_memfd_buffer::seal_immutable ) );
+
+    unique_fd handed = buffer.duplicate();
+
+    pid_t const child = ::fork();
+
+    if ( child == 0 )
+    {
+        // Child: only async-signal-safe operations and _exit():
+
+        unique_mapping view = make_file_mapping( handed.get(), 0, PROT_READ );
+
+        int status = 0;
+
+        if ( !view || view.size() != 8192 )
+            status |= 1;
+
+        for ( std::size_t i = 0; i < view.size(); ++i )
+        {
+            if ( view.data()[ i ] != 'm' )
+            {
+                status |= 2;
+                break;
+            }
+        }
+
+        if ( ::write( handed.get(), "x", 1 ) != -1 || errno != EPERM )
+            status |= 4;
+
+        ::_exit( status );
+    }
+
+    int status = -1;
+    EXPECT( ::waitpid( child, &status, 0 ) == child );
+    EXPECT( WIFEXITED( status ) );
+    EXPECT( WEXITSTATUS( status ) == 0 );
+}
+
+#else // scope_HAVE_UNIQUE_MEMFD_BUFFER
+
+CASE( "unique_memfd_buffer: not available" " [extension]" )
+{
+    EXPECT( !!"unique_memfd_buffer is not available (no C++11, not Linux, or extensions disabled)." );
+}
+
+#endif // scope_HAVE_UNIQUE_MEMFD_BUFFER
+
+// end of file
@@ -0,0 +1,170 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "scope-main.t.hpp"
+#include "nonstd/scope/unique_tempfile.hpp"
+
+#if scope_HAVE_UNIQUE_TEMPFILE
+
+#include "temp-directory.t.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <stdexcept>
+#include <string>
+
+using namespace nonstd;
+
+namespace {
+
+std::string contents( std::string const & path )
+{
+    unique_fd fd( ::open( path.c_str(), O_RDONLY | O_CLOEXEC ) );
+    char buffer[ 64 ] = {};
+    ssize_t const n = ::read( fd.get(), buffer, sizeof( buffer ) );
+    return std::string( buffer, n > 0 ? std::size_t( n ) : 0 );
+}
+
+} // anonymous namespace
+
+CASE( "unique_tempfile: an anonymous file leaves nothing behind" " [extension]" )
+{
+    temp_directory tmp( "scope-lite-tempfile" );
+
+    // scope:
+    {
+        unique_tempfile file = make_tempfile( tmp.path.c_str() );
+
+        EXPECT( !!file );
+        EXPECT( file.is_anonymous() );
+        EXPECT( ::write( file.get(), "spill", 5 ) == 5 );
+        EXPECT( tmp.entries() == 0u );
+    }
+
+    EXPECT( tmp.entries() == 0u );
+}
+
+CASE( "unique_tempfile: a named file is removed on destruction" " [extension]" )
+{
+    temp_directory tmp( "scope-lite-tempfile" );
+    std::string name;
+
+    // scope:
+    {
+        unique_tempfile file = make_named_tempfile( tmp.path.c_str() );
+        name = file.temporary_name();
+
+        EXPECT( !!file );
+        EXPECT_NOT( file.is_anonymous() );
+        EXPECT( ( ::fcntl( file.get(), F_GETFD ) & FD_CLOEXEC ) != 0 );
+        EXPECT( tmp.entries() == 1u );
+    }
+
+    EXPECT( tmp.entries() == 0u );
+    EXPECT( ::access( name.c_str(), F_OK ) != 0 );
+}
+
+CASE( "unique_tempfile: publish() gives the file its name" " [extension]" )
+{
+    temp_directory tmp( "scope-lite-tempfile" );
+    std::string const path = tmp.path + "/segment";
+
+    for ( int named = 0; named < 2; ++named )
+    {
+        // scope:
+        {
+            unique_tempfile file = named ? make_named_tempfile( tmp.path.c_str() ) : make_tempfile( tmp.path.c_str() );
+
+            EXPECT( ::write( file.get(), "data", 4 ) == 4 );
+            EXPECT( file.publish( path.c_str() ) );
+            EXPECT( file.temporary_name().empty() );
+        }
+
+        EXPECT( tmp.entries() == 1u );
+        EXPECT( contents( path ) == "data" );
+
+        ::unlink( path.c_str() );
+    }
+}
+
+CASE( "unique_tempfile: publish() relative to a unique_dirfd" " [extension]" )
+{
+    temp_directory tmp( "scope-lite-tempfile" );
+    unique_dirfd dir = open_directory( tmp.path.c_str() );
+
+    unique_tempfile file = make_tempfile( tmp.path.c_str() );
+
+    EXPECT( ::write( file.get(), "rel", 3 ) == 3 );
+    EXPECT( file.publish( dir, "segment" ) );
+    EXPECT( contents( tmp.path + "/segment" ) == "rel" );
+}
+
+CASE( "unique_tempfile: publish() does not replace an existing file" " [extension]" )
+{
+    temp_directory tmp( "scope-lite-tempfile" );
+    std::string const path = tmp.path + "/segment";
+
+    unique_fd( ::open( path.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC, 0600 ) );
+
+    unique_tempfile file = make_tempfile( tmp.path.c_str() );
+
+    EXPECT_NOT( file.publish( path.c_str() ) );
+    EXPECT( errno == EEXIST );
+}
+
+CASE( "unique_tempfile: publishes via scope_success only on success" " [extension]" )
+{
+    temp_directory tmp( "scope-lite-tempfile" );
+    std::string const good = tmp.path + "/good";
+    std::string const bad  = tmp.path + "/bad";
+
+    // scope:
+    {
+        unique_tempfile file = make_tempfile( tmp.path.c_str() );
+        auto guard = make_scope_success( [&]{ file.publish( good.c_str() ); } );
+    }
+
+    try
+    {
+        unique_tempfile file = make_tempfile( tmp.path.c_str() );
+        auto guard = make_scope_success( [&]{ file.publish( bad.c_str() ); } );
+
+        throw std::runtime_error( "spill failed" );
+    }
+    catch ( std::exception const & ) {}
+
+    EXPECT( ::access( good.c_str(), F_OK ) == 0 );
+    EXPECT( ::access( bad.c_str(), F_OK ) != 0 );
+    EXPECT( tmp.entries() == 1u );
+}
+
+CASE( "unique_tempfile: a missing directory yields a file that owns nothing" " [extension]" )
+{
+    temp_directory tmp( "scope-lite-tempfile" );
+
+    unique_tempfile file = make_tempfile( ( tmp.path + "/missing" ).c_str() );
+    int const error = errno;
+
+    EXPECT_NOT( !!file );
+    EXPECT( error == ENOENT );
+    EXPECT_NOT( file.publish( ( tmp.path + "/segment" ).c_str() ) );
+}
+
+#else // scope_HAVE_UNIQUE_TEMPFILE
+
+CASE( "unique_tempfile: not available" " [extension]" )
+{
+    EXPECT( !!"unique_tempfile is not available (no C++11, no <unistd.h>, or extensions disabled)." );
+}
+
+#endif // scope_HAVE_UNIQUE_TEMPFILE
+
+// end of file
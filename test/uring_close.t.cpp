@@ -0,0 +1,147 @@
+//
+// Copyright (c) 2020-2025 Martin Moene
+//
+// https://github.com/martinmoene/scope-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "scope-main.t.hpp"
+#include "nonstd/scope/uring_close.hpp"
+
+#if scope_HAVE_URING_CLOSE
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <thread>
+#include <vector>
+
+using namespace nonstd;
+
+namespace {
+
+typedef unique_resource<int, uring_close_deleter> uring_fd;
+
+bool is_open( int fd )
+{
+    return ::fcntl( fd, F_GETFD ) != -1;
+}
+
+} // anonymous namespace
+
+CASE( "uring_close_deleter: flush() closes the queued file descriptors" " [extension]" )
+{
+    int fds[2] = { -1, -1 };
+    EXPECT( ::pipe( fds ) == 0 );
+
+    // scope:
+    {
+        uring_fd r( fds[0], uring_close_deleter() );
+        uring_fd w( fds[1], uring_close_deleter() );
+    }
+
+    uring_close_deleter::flush();
+
+    EXPECT( uring_close_deleter::pending() == 0u );
+    EXPECT_NOT( is_open( fds[0] ) );
+    EXPECT_NOT( is_open( fds[1] ) );
+}
+
+CASE( "uring_close_deleter: a full batch is submitted without flush()" " [extension]" )
+{
+    std::vector<int> fds;
+
+    for ( int i = 0; i < 2 * scope_CONFIG_URING_BATCH_SIZE; ++i )
+    {
+        int const fd = ::open( "/dev/null", O_RDONLY );
+        fds.push_back( fd );
+
+        uring_fd( fd, uring_close_deleter() );
+    }
+
+    EXPECT( uring_close_deleter::pending() < std::size_t( scope_CONFIG_URING_BATCH_SIZE ) );
+
+    uring_close_deleter::flush();
+
+    for ( int fd : fds )
+        EXPECT_NOT( is_open( fd ) );
+}
+
+CASE( "uring_close_deleter: a thread's queued closes complete when it exits" " [extension][thread]" )
+{
+    int const fd = ::open( "/dev/null", O_RDONLY );
+
+    std::thread( [fd]{ uring_fd( fd, uring_close_deleter() ); } ).join();
+
+    EXPECT_NOT( is_open( fd ) );
+}
+
+CASE( "uring_close_deleter: a failed close is counted" " [extension]" )
+{
+    int const fd = ::open( "/dev/null", O_RDONLY );
+    EXPECT( ::close( fd ) == 0 );
+
+    uring_close_deleter::flush();
+    std::uint64_t const failed = uring_close_deleter::failed_count();
+
+    uring_close_deleter()( fd );
+    uring_close_deleter::flush();
+
+    EXPECT( uring_close_deleter::failed_count() == failed + 1 );
+}
+
+CASE( "uring_close_deleter: a forked child falls back to close()" " [extension]" )
+{
+    uring_close_deleter::flush();
+
+    pid_t const pid = ::fork();
+
+    if ( pid == 0 )
+    {
+        int const fd = ::open( "/dev/null", O_RDONLY );
+
+        uring_close_deleter()( fd );
+
+        ::_exit( !uring_close_deleter::is_available() && !is_open( fd ) ? 0 : 1 );
+    }
+
+    int status = -1;
+    EXPECT( ::waitpid( pid, &status, 0 ) == pid );
+    EXPECT( WIFEXITED( status ) );
+    EXPECT( WEXITSTATUS( status ) == 0 );
+}
+
+CASE( "uring_close_deleter: a forked child closes its copies of the closes queued at the fork" " [extension]" )
+{
+    uring_close_deleter::flush();
+
+    int const fd = ::open( "/dev/null", O_RDONLY );
+    uring_close_deleter()( fd );
+
+    bool const queued = uring_close_deleter::pending() == 1u;
+
+    pid_t const pid = ::fork();
+
+    if ( pid == 0 )
+        ::_exit( !uring_close_deleter::is_available() && !is_open( fd ) ? 0 : 1 );
+
+    int status = -1;
+    EXPECT( ::waitpid( pid, &status, 0 ) == pid );
+    EXPECT( WIFEXITED( status ) );
+    EXPECT( WEXITSTATUS( status ) == 0 );
+
+    EXPECT( is_open( fd ) == queued );
+    uring_close_deleter::flush();
+    EXPECT_NOT( is_open( fd ) );
+}
+
+#else // scope_HAVE_URING_CLOSE
+
+CASE( "uring_close_deleter: not available" " [extension]" )
+{
+    EXPECT( !!"uring_close_deleter is not available (no C++11, no Linux io_uring, or extensions disabled)." );
+}
+
+#endif // scope_HAVE_URING_CLOSE
+
+// end of file